@@ -0,0 +1,361 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "glfw-inputs.hpp"
+
+/**
+ * Dispatch benchmarks
+ *
+ * Measures the cost of dispatching synthetic inputs through the Manager,
+ * in nanoseconds and heap allocations per event. Inputs are injected with
+ * a SyntheticBackend, so no window, display or joystick is needed.
+ *
+ * Build in release mode to get representative numbers:
+ *
+ *     cmake -S . -B build -DCMAKE_BUILD_TYPE=Release
+ *     cmake --build build --target dispatch_benchmark
+ */
+
+using namespace GLFW_Inputs;
+
+// Allocation counting
+// All heap allocations in the process go through these replacements
+
+static std::atomic<std::size_t> allocations{0};
+
+void *operator new(std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *memory = std::malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+// GCC can't tell that these replace the operator new above, which uses malloc
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, const std::nothrow_t &) noexcept
+{
+    std::free(memory);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+struct Result {
+    double nanosecondsPerEvent;
+    double allocationsPerEvent;
+};
+
+/**
+ * Run a workload, and measure time and allocations
+ *
+ * @param std::size_t events Number of events produced by the workload
+ * @param Workload workload
+ * @return Result
+ */
+template<typename Workload>
+Result measure(std::size_t events, Workload workload)
+{
+    // Warm-up, so one-time allocations (such as growing containers) aren't counted
+    workload();
+
+    std::size_t allocationsBefore = allocations.load();
+    auto start = std::chrono::steady_clock::now();
+    workload();
+    auto end = std::chrono::steady_clock::now();
+    std::size_t allocationsAfter = allocations.load();
+
+    return {
+        .nanosecondsPerEvent = std::chrono::duration<double, std::nano>(end - start).count() / events,
+        .allocationsPerEvent = static_cast<double>(allocationsAfter - allocationsBefore) / events,
+    };
+}
+
+/**
+ * @param const char* workload
+ * @param std::size_t size Number of mappings, or of joysticks for joysticks-tick
+ * @param Result result
+ */
+void report(const char *workload, std::size_t size, Result result)
+{
+    std::printf("%-16s %8zu %12.1f %14.3f\n",
+                workload,
+                size,
+                result.nanosecondsPerEvent,
+                result.allocationsPerEvent);
+}
+
+/**
+ * Signal names may only contain letters and underscores,
+ * so the number is encoded with letters
+ */
+std::string signalName(std::size_t number)
+{
+    std::string name = "signal_";
+    do {
+        name += static_cast<char>('a' + number % 26);
+        number /= 26;
+    } while (number > 0);
+    return name;
+}
+
+/**
+ * Keys used by the keyboard workloads
+ */
+Input keyAt(std::size_t index)
+{
+    return static_cast<Input>(GLFW_KEY_SPACE + index % (GLFW_KEY_LAST - GLFW_KEY_SPACE));
+}
+
+/**
+ * Map the given number of (event, key) combinations to signals,
+ * and listen for all of them
+ */
+void populate(ControlMapping &mapping, Manager &manager, std::size_t count, std::size_t &received)
+{
+    const Event events[] = {Event::ButtonPress, Event::ButtonRelease, Event::ButtonDown};
+    for (std::size_t i = 0; i < count; i++) {
+        std::string signal = signalName(i);
+        mapping.on(events[i / (GLFW_KEY_LAST - GLFW_KEY_SPACE) % eventCount], keyAt(i), signal);
+        manager.listenFor(signal, [&received](const ReceivedSignal &) {
+            received++;
+        });
+    }
+}
+
+void benchmarkKeyboard(std::size_t mappings)
+{
+    constexpr std::size_t iterations = 200000;
+
+    SyntheticBackend backend;
+    Manager manager(backend);
+    KeyboardMapping keyboardMapping;
+    Keyboard keyboard;
+    keyboard.mapping = &keyboardMapping;
+    manager.setKeyboard(&keyboard);
+
+    std::size_t received = 0;
+    populate(keyboardMapping, manager, mappings, received);
+
+    Result result = measure(iterations * 2, [&]() {
+        for (std::size_t i = 0; i < iterations; i++) {
+            int key = keyAt(i % mappings);
+            backend.key(key, GLFW_PRESS);
+            backend.key(key, GLFW_RELEASE);
+        }
+    });
+    report("keyboard", mappings, result);
+}
+
+void benchmarkTick(std::size_t mappings)
+{
+    constexpr std::size_t iterations = 20000;
+    constexpr std::size_t held = 16;
+
+    SyntheticBackend backend;
+    Manager manager(backend);
+    KeyboardMapping keyboardMapping;
+    Keyboard keyboard;
+    keyboard.mapping = &keyboardMapping;
+    manager.setKeyboard(&keyboard);
+
+    std::size_t received = 0;
+    populate(keyboardMapping, manager, mappings, received);
+
+    // Hold down a number of keys, so each tick emits ButtonDown events
+    for (std::size_t i = 0; i < held; i++) {
+        backend.key(keyAt(i), GLFW_PRESS);
+    }
+
+    Result result = measure(iterations, [&]() {
+        for (std::size_t i = 0; i < iterations; i++) {
+            manager.tick();
+        }
+    });
+    report("keyboard-tick", mappings, result);
+}
+
+void benchmarkMouseMove()
+{
+    constexpr std::size_t iterations = 200000;
+
+    SyntheticBackend backend;
+    Manager manager(backend);
+    MouseMapping mouseMapping;
+    Mouse mouse;
+    mouse.mapping = &mouseMapping;
+    manager.setMouse(&mouse);
+
+    double sum = 0;
+    mouseMapping.onMove = [&sum](MotionEvent motionEvent) {
+        if (motionEvent.relative.has_value()) {
+            sum += motionEvent.relative->x;
+        }
+    };
+
+    Result result = measure(iterations, [&]() {
+        for (std::size_t i = 0; i < iterations; i++) {
+            backend.cursor(static_cast<double>(i % 1920), static_cast<double>(i % 1080));
+        }
+    });
+    report("mouse-move", 0, result);
+}
+
+void benchmarkMouseMoveCoalesced(std::size_t movesPerTick)
+{
+    constexpr std::size_t iterations = 20000;
+
+    SyntheticBackend backend;
+    Manager manager(backend);
+    MouseMapping mouseMapping;
+    Mouse mouse;
+    mouse.mapping = &mouseMapping;
+    manager.setMouse(&mouse);
+    manager.setCoalescedMotion(true);
+
+    double sum = 0;
+    mouseMapping.onMove = [&sum](MotionEvent motionEvent) {
+        if (motionEvent.relative.has_value()) {
+            sum += motionEvent.relative->x;
+        }
+    };
+
+    // Measured per cursor event, including the share of the tick
+    Result result = measure(iterations * movesPerTick, [&]() {
+        for (std::size_t i = 0; i < iterations; i++) {
+            for (std::size_t move = 0; move < movesPerTick; move++) {
+                backend.cursor(static_cast<double>((i + move) % 1920), static_cast<double>(i % 1080));
+            }
+            manager.tick();
+        }
+    });
+    report("mouse-coalesced", 0, result);
+}
+
+void benchmarkJoystick(std::size_t mappings)
+{
+    constexpr std::size_t iterations = 100000;
+
+    SyntheticBackend backend;
+    backend.connectJoystick(GLFW_JOYSTICK_1, "Benchmark", Manager::joystickButtonCount, 4);
+
+    Manager manager(backend);
+    JoystickMapping joystickMapping;
+    Joystick joystick(GLFW_JOYSTICK_1, backend);
+    joystick.mapping = &joystickMapping;
+    manager.setJoysticks({&joystick});
+
+    std::size_t received = 0;
+    const Event events[] = {Event::ButtonPress, Event::ButtonRelease, Event::ButtonDown};
+    for (std::size_t i = 0; i < mappings; i++) {
+        std::string signal = signalName(i);
+        joystickMapping.on(events[i / Manager::joystickButtonCount % eventCount],
+                           Manager::translateJoystickButton(static_cast<int>(i % Manager::joystickButtonCount)),
+                           signal);
+        manager.listenFor(signal, [&received](const ReceivedSignal &) {
+            received++;
+        });
+    }
+
+    bool buttons[Manager::joystickButtonCount] = {};
+    Result result = measure(iterations, [&]() {
+        for (std::size_t i = 0; i < iterations; i++) {
+            // Toggle one button per tick, which produces press, release and down events
+            int button = static_cast<int>(i % Manager::joystickButtonCount);
+            buttons[button] = !buttons[button];
+            backend.setJoystickButton(GLFW_JOYSTICK_1, button, buttons[button]);
+            backend.setJoystickAxis(GLFW_JOYSTICK_1, 0, static_cast<float>(i % 100) / 100.0f);
+            manager.tick();
+        }
+    });
+    report("joystick-tick", mappings, result);
+}
+
+void benchmarkJoysticks(std::size_t count)
+{
+    constexpr std::size_t iterations = 20000;
+
+    SyntheticBackend backend;
+    Manager manager(backend);
+    JoystickMapping joystickMapping;
+    joystickMapping.axisFilter.deadzone = Deadzone::Radial;
+    joystickMapping.axisFilter.innerDeadzone = 0.1;
+
+    std::size_t moves = 0;
+    joystickMapping.onMove = [&moves](MotionEvent) {
+        moves++;
+    };
+
+    std::vector<std::unique_ptr<Joystick>> joysticks;
+    std::vector<Joystick *> pointers;
+    for (std::size_t i = 0; i < count; i++) {
+        backend.connectJoystick(static_cast<int>(i), "Benchmark", Manager::joystickButtonCount, 4);
+        joysticks.push_back(std::make_unique<Joystick>(static_cast<int>(i), backend));
+        joysticks.back()->mapping = &joystickMapping;
+        pointers.push_back(joysticks.back().get());
+    }
+    manager.setJoysticks(pointers);
+
+    // Idle sticks drift within the deadzone, while one stick moves per tick
+    Result result = measure(iterations, [&]() {
+        for (std::size_t i = 0; i < iterations; i++) {
+            backend.setJoystickAxis(static_cast<int>(i % count), 1, static_cast<float>(i % 7) * 0.01f);
+            backend.setJoystickAxis(static_cast<int>(i % count), 0, static_cast<float>(i % 100) / 100.0f);
+            manager.tick();
+        }
+    });
+    report("joysticks-tick", count, result);
+}
+
+int main()
+{
+    // Unmapped or unhandled signals are expected in some workloads
+    Messaging::warnings = MessagingMethod::Silent;
+
+    std::printf("%-16s %8s %12s %14s\n", "workload", "size", "ns/event", "allocs/event");
+
+    for (std::size_t mappings : {1, 16, 128, 512}) {
+        benchmarkKeyboard(mappings);
+    }
+    for (std::size_t mappings : {1, 16, 128, 512}) {
+        benchmarkTick(mappings);
+    }
+    benchmarkMouseMove();
+    benchmarkMouseMoveCoalesced(8);
+    for (std::size_t mappings : {1, 12, 36}) {
+        benchmarkJoystick(mappings);
+    }
+    for (std::size_t count : {1, 8, 16}) {
+        benchmarkJoysticks(count);
+    }
+
+    return 0;
+}
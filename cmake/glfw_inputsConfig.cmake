@@ -1,24 +1,26 @@
-include(CMakePackageConfigHelpers)
+include(CMakeFindDependencyMacro)
 
-get_filename_component(GLFW_INPUTS_LIB_DIR "${CMAKE_CURRENT_LIST_DIR}/../" ABSOLUTE)
+if (NOT TARGET glfw)
+    find_dependency(glfw3)
+endif ()
 
-add_library(glfw_inputs
-        INTERFACE
-        ${GLFW_INPUTS_LIB_DIR}/include/glfw-inputs/glfw-inputs.hpp
-)
+if (EXISTS "${CMAKE_CURRENT_LIST_DIR}/glfw_inputsTargets.cmake")
+    # Installed or built package, with the compiled library
+    include("${CMAKE_CURRENT_LIST_DIR}/glfw_inputsTargets.cmake")
+elseif (NOT TARGET glfw_inputs::glfw_inputs)
+    # The repository itself, used header-only, under the same
+    # name as the compiled library (and the former glfw_inputs)
+    get_filename_component(GLFW_INPUTS_LIB_DIR "${CMAKE_CURRENT_LIST_DIR}/../" ABSOLUTE)
 
-target_include_directories(glfw_inputs
-        INTERFACE
-        $<BUILD_INTERFACE:${GLFW_INPUTS_LIB_DIR}/include>
-        $<INSTALL_INTERFACE:include>
-)
+    add_library(glfw_inputs INTERFACE)
 
-export(TARGETS glfw_inputs
-        FILE ${CMAKE_CURRENT_BINARY_DIR}/glfw_inputsTargets.cmake)
+    target_include_directories(glfw_inputs
+            INTERFACE
+            ${GLFW_INPUTS_LIB_DIR}/include)
 
-install(
-        FILES
-        "${CMAKE_CURRENT_BINARY_DIR}/glfw_inputsConfig.cmake"
-        "${CMAKE_CURRENT_BINARY_DIR}/glfw_inputsConfigVersion.cmake"
-        DESTINATION lib/cmake/glfw-inputs
-)
+    target_compile_features(glfw_inputs INTERFACE cxx_std_17)
+
+    target_link_libraries(glfw_inputs INTERFACE glfw)
+
+    add_library(glfw_inputs::glfw_inputs ALIAS glfw_inputs)
+endif ()
@@ -0,0 +1,113 @@
+#ifndef GLFW_INPUTS_TESTS_AXIS_FILTER_HPP
+#define GLFW_INPUTS_TESTS_AXIS_FILTER_HPP
+
+#include "enums.hpp"
+#include <cstddef>
+
+namespace GLFW_Inputs {
+
+    /**
+     * Axis Filter State
+     *
+     * The smoothing state of a pair of axes, kept between updates
+     */
+    struct AxisFilterState {
+        double x = 0.0, y = 0.0;
+        double derivativeX = 0.0, derivativeY = 0.0;
+        bool initialized = false;
+    };
+
+    /**
+     * Axis Filter
+     *
+     * Configures the pipeline applied to the analog axes of joysticks
+     * and gamepads before they're dispatched: deadzone, then response
+     * curve, then smoothing.
+     *
+     * The stages process arrays of axis pairs (X and Y of each stick)
+     * with simple loops, which the compiler can vectorize when many
+     * pairs are filtered at once.
+     *
+     * @see https://glfw-inputs.readthedocs.io/en/latest/misc/axis-filter/
+     */
+    struct AxisFilter {
+        Deadzone deadzone = Deadzone::None;
+
+        /**
+         * Values within the inner deadzone become 0, and the remaining
+         * range is rescaled to start at 0
+         */
+        double innerDeadzone = 0.0;
+
+        /**
+         * Values within the outer deadzone (measured from the edge) become 1,
+         * which compensates for sticks which don't reach their full range
+         */
+        double outerDeadzone = 0.0;
+
+        /**
+         * Response curve, applied as sign(v) * |v|^exponent
+         * 1 is linear, 2 is quadratic, and so on
+         */
+        double exponent = 1.0;
+
+        Smoothing smoothing = Smoothing::None;
+
+        /**
+         * Smoothing::Exponential: weight of the new value (0 to 1)
+         */
+        double smoothingFactor = 0.5;
+
+        /**
+         * Smoothing::OneEuro: the minimum cutoff frequency (in Hz), and how much
+         * the cutoff increases with the speed of the movement. Lower cutoffs
+         * reduce jitter, and higher betas reduce lag during fast movements.
+         */
+        double minCutoff = 1.0;
+        double beta = 0.0;
+        double derivativeCutoff = 1.0;
+
+        /**
+         * Movements of at most this amount (per axis) aren't dispatched
+         */
+        double threshold = 0.0;
+
+        /**
+         * Filter pairs of axes
+         *
+         * @param AxisFilterState* states Smoothing state of each pair
+         * @param double* x X values, filtered in place
+         * @param double* y Y values, filtered in place
+         * @param std::size_t count Number of pairs
+         * @param double deltaTime Seconds since the previous update
+         * @return void
+         */
+        void apply(AxisFilterState *states, double *x, double *y, std::size_t count, double deltaTime) const;
+
+        void applyDeadzone(double *x, double *y, std::size_t count) const;
+
+        void applyCurve(double *values, std::size_t count) const;
+
+        void applySmoothing(AxisFilterState *states,
+                            double *x,
+                            double *y,
+                            std::size_t count,
+                            double deltaTime) const;
+
+    private:
+
+        /**
+         * Rescale a magnitude from the range between the deadzones to 0..1
+         */
+        double rescale(double magnitude, double range) const;
+
+        /**
+         * Smoothing factor of a low-pass filter with the given cutoff frequency
+         */
+        static double alpha(double cutoff, double deltaTime);
+
+    };
+
+}
+
+#endif
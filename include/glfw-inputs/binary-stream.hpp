@@ -0,0 +1,288 @@
+#ifndef GLFW_INPUTS_TESTS_BINARY_STREAM_HPP
+#define GLFW_INPUTS_TESTS_BINARY_STREAM_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <memory>
+#include <ostream>
+
+namespace GLFW_Inputs {
+
+    /**
+     * Binary Writer
+     *
+     * Encodes values into a fixed-size buffer, which is written to the
+     * stream whenever it's full. Memory usage is therefore bounded,
+     * regardless of how much is written.
+     *
+     * Integers are written as variable-length integers (LEB128), and
+     * floating-point values as little-endian IEEE 754.
+     */
+    class BinaryWriter {
+    public:
+
+        /**
+         * Smallest buffer, which holds any single value
+         */
+        static constexpr std::size_t minBufferSize = 16;
+
+        /**
+         * @param std::ostream& stream
+         * @param std::size_t bufferSize Raised to minBufferSize if smaller
+         */
+        explicit BinaryWriter(std::ostream &stream, std::size_t bufferSize = 64 * 1024)
+            : stream(stream),
+              size(std::max(bufferSize, minBufferSize)),
+              buffer(std::make_unique<unsigned char[]>(size)) { }
+
+        BinaryWriter(const BinaryWriter &) = delete;
+
+        BinaryWriter &operator=(const BinaryWriter &) = delete;
+
+        ~BinaryWriter()
+        {
+            flush();
+        }
+
+        void writeByte(std::uint8_t value)
+        {
+            reserve(1);
+            buffer[used++] = value;
+        }
+
+        /**
+         * Write an unsigned variable-length integer (1 to 10 bytes)
+         *
+         * @param std::uint64_t value
+         * @return void
+         */
+        void writeVarint(std::uint64_t value)
+        {
+            reserve(10);
+            while (value >= 0x80) {
+                buffer[used++] = static_cast<unsigned char>(value | 0x80);
+                value >>= 7;
+            }
+            buffer[used++] = static_cast<unsigned char>(value);
+        }
+
+        /**
+         * Write a signed variable-length integer, zigzag-encoded so
+         * small negative values are as compact as small positive values
+         *
+         * @param std::int64_t value
+         * @return void
+         */
+        void writeSignedVarint(std::int64_t value)
+        {
+            writeVarint((static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63));
+        }
+
+        void writeFloat(float value)
+        {
+            std::uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            writeLittleEndian(bits, sizeof(bits));
+        }
+
+        void writeDouble(double value)
+        {
+            std::uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            writeLittleEndian(bits, sizeof(bits));
+        }
+
+        void writeBytes(const void *data, std::size_t count)
+        {
+            const auto *bytes = static_cast<const unsigned char *>(data);
+            while (count > 0) {
+                reserve(1);
+                std::size_t chunk = std::min(count, size - used);
+                std::memcpy(&buffer[used], bytes, chunk);
+                used += chunk;
+                bytes += chunk;
+                count -= chunk;
+            }
+        }
+
+        /**
+         * Write the buffered bytes to the stream
+         *
+         * @return void
+         */
+        void flush()
+        {
+            if (used > 0) {
+                stream.write(reinterpret_cast<const char *>(buffer.get()), static_cast<std::streamsize>(used));
+                used = 0;
+            }
+            stream.flush();
+        }
+
+    private:
+        std::ostream &stream;
+
+        std::size_t size;
+
+        std::unique_ptr<unsigned char[]> buffer;
+
+        std::size_t used = 0;
+
+        /**
+         * Make room for the given number of bytes in the buffer
+         */
+        void reserve(std::size_t count)
+        {
+            if (size - used < count) {
+                stream.write(reinterpret_cast<const char *>(buffer.get()), static_cast<std::streamsize>(used));
+                used = 0;
+            }
+        }
+
+        void writeLittleEndian(std::uint64_t value, std::size_t count)
+        {
+            reserve(count);
+            for (std::size_t i = 0; i < count; i++) {
+                buffer[used++] = static_cast<unsigned char>(value >> (8 * i));
+            }
+        }
+
+    };
+
+    /**
+     * Binary Reader
+     *
+     * Decodes the values written by BinaryWriter, reading the stream
+     * in fixed-size chunks.
+     *
+     * All methods return false when the end of the stream is reached
+     * before the value is complete.
+     */
+    class BinaryReader {
+    public:
+
+        /**
+         * @param std::istream& stream
+         * @param std::size_t bufferSize Raised to BinaryWriter::minBufferSize if smaller
+         */
+        explicit BinaryReader(std::istream &stream, std::size_t bufferSize = 64 * 1024)
+            : stream(stream),
+              size(std::max(bufferSize, BinaryWriter::minBufferSize)),
+              buffer(std::make_unique<unsigned char[]>(size)) { }
+
+        BinaryReader(const BinaryReader &) = delete;
+
+        BinaryReader &operator=(const BinaryReader &) = delete;
+
+        bool readByte(std::uint8_t &value)
+        {
+            if (position == available && !refill()) {
+                return false;
+            }
+            value = buffer[position++];
+            return true;
+        }
+
+        bool readVarint(std::uint64_t &value)
+        {
+            value = 0;
+            for (unsigned shift = 0; shift < 64; shift += 7) {
+                std::uint8_t byte;
+                if (!readByte(byte)) {
+                    return false;
+                }
+                value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool readSignedVarint(std::int64_t &value)
+        {
+            std::uint64_t encoded;
+            if (!readVarint(encoded)) {
+                return false;
+            }
+            value = static_cast<std::int64_t>(encoded >> 1) ^ -static_cast<std::int64_t>(encoded & 1);
+            return true;
+        }
+
+        bool readFloat(float &value)
+        {
+            std::uint64_t bits;
+            if (!readLittleEndian(bits, sizeof(std::uint32_t))) {
+                return false;
+            }
+            auto bits32 = static_cast<std::uint32_t>(bits);
+            std::memcpy(&value, &bits32, sizeof(value));
+            return true;
+        }
+
+        bool readDouble(double &value)
+        {
+            std::uint64_t bits;
+            if (!readLittleEndian(bits, sizeof(bits))) {
+                return false;
+            }
+            std::memcpy(&value, &bits, sizeof(value));
+            return true;
+        }
+
+        bool readBytes(void *data, std::size_t count)
+        {
+            auto *bytes = static_cast<unsigned char *>(data);
+            while (count > 0) {
+                if (position == available && !refill()) {
+                    return false;
+                }
+                std::size_t chunk = std::min(count, available - position);
+                std::memcpy(bytes, &buffer[position], chunk);
+                position += chunk;
+                bytes += chunk;
+                count -= chunk;
+            }
+            return true;
+        }
+
+    private:
+        std::istream &stream;
+
+        std::size_t size;
+
+        std::unique_ptr<unsigned char[]> buffer;
+
+        std::size_t position = 0;
+
+        std::size_t available = 0;
+
+        bool refill()
+        {
+            stream.read(reinterpret_cast<char *>(buffer.get()), static_cast<std::streamsize>(size));
+            available = static_cast<std::size_t>(stream.gcount());
+            position = 0;
+            return available > 0;
+        }
+
+        bool readLittleEndian(std::uint64_t &value, std::size_t count)
+        {
+            value = 0;
+            for (std::size_t i = 0; i < count; i++) {
+                std::uint8_t byte;
+                if (!readByte(byte)) {
+                    return false;
+                }
+                value |= static_cast<std::uint64_t>(byte) << (8 * i);
+            }
+            return true;
+        }
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,215 @@
+#ifndef GLFW_INPUTS_TESTS_BUTTON_SET_HPP
+#define GLFW_INPUTS_TESTS_BUTTON_SET_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace GLFW_Inputs {
+
+    /**
+     * Button Set
+     *
+     * Fixed-size set of button states, packed as bits into 64-bit words.
+     * Queries are O(1), and iterating the set buttons skips over whole
+     * words of released buttons, without allocating.
+     *
+     * The words are exposed, so whole sets can be compared word-wise,
+     * for example to find the buttons which changed between two frames.
+     */
+    template<std::size_t Size>
+    class ButtonSet {
+    public:
+        using Word = std::uint64_t;
+
+        static constexpr std::size_t bitsPerWord = 64;
+
+        static constexpr std::size_t wordCount = (Size + bitsPerWord - 1) / bitsPerWord;
+
+        /**
+         * Iterator over the indexes of the set buttons
+         */
+        class Iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::size_t;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const std::size_t *;
+            using reference = std::size_t;
+
+            Iterator(const ButtonSet *set, std::size_t wordIndex) : set(set), wordIndex(wordIndex)
+            {
+                if (wordIndex < wordCount) {
+                    remaining = set->words[wordIndex];
+                    skipEmptyWords();
+                }
+            }
+
+            std::size_t operator*() const
+            {
+                return wordIndex * bitsPerWord + countTrailingZeros(remaining);
+            }
+
+            Iterator &operator++()
+            {
+                // Clear the lowest set bit
+                remaining &= remaining - 1;
+                skipEmptyWords();
+                return *this;
+            }
+
+            Iterator operator++(int)
+            {
+                Iterator previous = *this;
+                ++(*this);
+                return previous;
+            }
+
+            bool operator==(const Iterator &other) const
+            {
+                return wordIndex == other.wordIndex && remaining == other.remaining;
+            }
+
+            bool operator!=(const Iterator &other) const
+            {
+                return !(*this == other);
+            }
+
+        private:
+            const ButtonSet *set;
+            std::size_t wordIndex;
+            Word remaining = 0;
+
+            void skipEmptyWords()
+            {
+                while (remaining == 0 && ++wordIndex < wordCount) {
+                    remaining = set->words[wordIndex];
+                }
+            }
+        };
+
+        /**
+         * Set the state of a button
+         *
+         * Indexes outside the set are ignored
+         *
+         * @param std::size_t index
+         * @param bool down
+         * @return void
+         */
+        void set(std::size_t index, bool down = true)
+        {
+            if (index >= Size) {
+                return;
+            }
+
+            Word bit = Word(1) << (index % bitsPerWord);
+            if (down) {
+                words[index / bitsPerWord] |= bit;
+            } else {
+                words[index / bitsPerWord] &= ~bit;
+            }
+        }
+
+        /**
+         * Returns true if the button is set
+         *
+         * @param std::size_t index
+         * @return bool False for indexes outside the set
+         */
+        [[nodiscard]] bool test(std::size_t index) const
+        {
+            if (index >= Size) {
+                return false;
+            }
+            return (words[index / bitsPerWord] >> (index % bitsPerWord)) & 1;
+        }
+
+        /**
+         * Clear all buttons
+         *
+         * @return void
+         */
+        void clear()
+        {
+            words.fill(0);
+        }
+
+        /**
+         * Returns true if any button is set
+         *
+         * @return bool
+         */
+        [[nodiscard]] bool any() const
+        {
+            for (Word word : words) {
+                if (word != 0) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * Direct access to a word of packed button states
+         *
+         * @param std::size_t index
+         * @return Word&
+         */
+        Word &word(std::size_t index)
+        {
+            return words[index];
+        }
+
+        [[nodiscard]] Word word(std::size_t index) const
+        {
+            return words[index];
+        }
+
+        [[nodiscard]] Iterator begin() const
+        {
+            return Iterator(this, 0);
+        }
+
+        [[nodiscard]] Iterator end() const
+        {
+            return Iterator(this, wordCount);
+        }
+
+        /**
+         * Index of the lowest set bit of a (non-zero) word
+         *
+         * @param Word word
+         * @return std::size_t
+         */
+        static std::size_t countTrailingZeros(Word word)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<std::size_t>(__builtin_ctzll(word));
+#elif defined(_MSC_VER) && defined(_M_X64)
+            unsigned long index;
+            _BitScanForward64(&index, word);
+            return index;
+#else
+            std::size_t index = 0;
+            while ((word & 1) == 0) {
+                word >>= 1;
+                index++;
+            }
+            return index;
+#endif
+        }
+
+    private:
+        std::array<Word, wordCount> words{};
+
+    };
+
+}
+
+#endif
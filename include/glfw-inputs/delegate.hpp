@@ -0,0 +1,181 @@
+#ifndef GLFW_INPUTS_TESTS_DELEGATE_HPP
+#define GLFW_INPUTS_TESTS_DELEGATE_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace GLFW_Inputs {
+
+    /**
+     * Delegate
+     *
+     * A move-only callable wrapper, similar to std::function, which stores
+     * small callables inside the object itself (small-buffer storage).
+     * Lambdas capturing a handful of references don't allocate, which keeps
+     * containers of delegates contiguous in memory and cheap to invoke.
+     *
+     * Callables which don't fit in the inline storage (or can't be moved
+     * without throwing) are allocated on the heap instead.
+     */
+    template<typename Signature, std::size_t Capacity = 48>
+    class Delegate;
+
+    template<typename R, typename... Args, std::size_t Capacity>
+    class Delegate<R(Args...), Capacity> {
+    public:
+
+        /**
+         * Create an empty delegate
+         */
+        Delegate() = default;
+
+        /**
+         * Create a delegate wrapping the provided callable
+         *
+         * @param F&& callable
+         */
+        template<typename F,
+                typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Delegate>>>
+        Delegate(F &&callable)
+        {
+            using Callable = std::decay_t<F>;
+            static_assert(std::is_invocable_r_v<R, Callable &, Args...>,
+                          "Callable cannot be invoked with the arguments of Delegate");
+
+            if constexpr (fitsInline<Callable>()) {
+                new (&storage) Callable(std::forward<F>(callable));
+
+                invoker = [](void *target, Args... args) -> R {
+                    return (*static_cast<Callable *>(target))(std::forward<Args>(args)...);
+                };
+
+                manager = [](void *destination, void *source) {
+                    auto *from = static_cast<Callable *>(source);
+                    if (destination) {
+                        new (destination) Callable(std::move(*from));
+                    }
+                    from->~Callable();
+                };
+            } else {
+                // The storage holds a pointer to the callable, which moves with it
+                new (&storage) Callable *(new Callable(std::forward<F>(callable)));
+
+                invoker = [](void *target, Args... args) -> R {
+                    return (**static_cast<Callable **>(target))(std::forward<Args>(args)...);
+                };
+
+                manager = [](void *destination, void *source) {
+                    Callable *from = *static_cast<Callable **>(source);
+                    if (destination) {
+                        new (destination) Callable *(from);
+                    } else {
+                        delete from;
+                    }
+                };
+            }
+        }
+
+        Delegate(Delegate &&other) noexcept
+        {
+            moveFrom(other);
+        }
+
+        Delegate &operator=(Delegate &&other) noexcept
+        {
+            if (this != &other) {
+                reset();
+                moveFrom(other);
+            }
+            return *this;
+        }
+
+        Delegate(const Delegate &) = delete;
+
+        Delegate &operator=(const Delegate &) = delete;
+
+        ~Delegate()
+        {
+            reset();
+        }
+
+        /**
+         * Invoke the wrapped callable
+         *
+         * Must not be called on an empty delegate
+         *
+         * @param Args... args
+         * @return R
+         */
+        R operator()(Args... args) const
+        {
+            return invoker(const_cast<void *>(static_cast<const void *>(&storage)),
+                           std::forward<Args>(args)...);
+        }
+
+        /**
+         * Returns true if the delegate wraps a callable
+         */
+        explicit operator bool() const
+        {
+            return invoker != nullptr;
+        }
+
+        /**
+         * Destroy the wrapped callable, leaving the delegate empty
+         *
+         * @return void
+         */
+        void reset()
+        {
+            if (manager) {
+                manager(nullptr, &storage);
+            }
+            invoker = nullptr;
+            manager = nullptr;
+        }
+
+        /**
+         * Returns true if the callable is stored inline, without allocating
+         *
+         * @return bool
+         */
+        template<typename Callable>
+        static constexpr bool fitsInline()
+        {
+            return sizeof(Callable) <= Capacity
+                && alignof(Callable) <= alignof(std::max_align_t)
+                && std::is_nothrow_move_constructible_v<Callable>;
+        }
+
+    private:
+        static_assert(Capacity >= sizeof(void *), "Delegate needs room for a pointer");
+
+        alignas(std::max_align_t) unsigned char storage[Capacity];
+
+        R (*invoker)(void *, Args...) = nullptr;
+
+        /**
+         * Moves the callable from source into destination (when not nullptr),
+         * and destroys the callable in source
+         */
+        void (*manager)(void *, void *) = nullptr;
+
+        void moveFrom(Delegate &other)
+        {
+            if (!other.manager) {
+                return;
+            }
+            other.manager(&storage, &other.storage);
+            invoker = other.invoker;
+            manager = other.manager;
+            other.invoker = nullptr;
+            other.manager = nullptr;
+        }
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,119 @@
+#ifndef GLFW_INPUTS_TESTS_ACTION_SNAPSHOT_BUFFER_HPP
+#define GLFW_INPUTS_TESTS_ACTION_SNAPSHOT_BUFFER_HPP
+
+#include "../glfw-inputs.hpp"
+#include <atomic>
+
+namespace GLFW_Inputs {
+
+    /**
+     * Action Snapshot Buffer
+     *
+     * Double buffer of ActionSnapshots: the Manager builds the snapshot
+     * of the current tick in one, while the snapshot of the previous
+     * tick is read from the other. Publishing swaps them.
+     */
+    class ActionSnapshotBuffer {
+    public:
+
+        /**
+         * Record a signal in the snapshot being built
+         *
+         * @param SignalId signalId
+         * @param Event event
+         * @return void
+         */
+        void record(SignalId signalId, Event event)
+        {
+            ActionSnapshot &snapshot = back();
+            fit(snapshot, signalId);
+
+            switch (event) {
+                case Event::ButtonPress:
+                    snapshot.states[signalId] |= ActionSnapshot::pressed;
+                    break;
+                case Event::ButtonDown:
+                    snapshot.states[signalId] |= ActionSnapshot::held;
+                    break;
+                case Event::ButtonRelease:
+                    snapshot.states[signalId] |= ActionSnapshot::released;
+                    break;
+            }
+        }
+
+        /**
+         * Set the value of a signal in the snapshot being built
+         *
+         * @param SignalId signalId
+         * @param Position value
+         * @return void
+         */
+        void setValue(SignalId signalId, Position value)
+        {
+            ActionSnapshot &snapshot = back();
+            fit(snapshot, signalId);
+            snapshot.states[signalId] |= ActionSnapshot::valued;
+            snapshot.values[signalId] = value;
+        }
+
+        /**
+         * Publish the snapshot being built, and start building the next one
+         *
+         * The previously published snapshot is reused for the next one,
+         * so it must no longer be read once this is called.
+         *
+         * @param Timestamp timestamp Time of the tick
+         * @return void
+         */
+        void publish(Timestamp timestamp)
+        {
+            unsigned built = 1 - front.load(std::memory_order_relaxed);
+            buffers[built].frame = ++frames;
+            buffers[built].timestamp = timestamp;
+            front.store(built, std::memory_order_release);
+
+            // Sized for all signals known so far, so recording doesn't allocate
+            ActionSnapshot &next = buffers[1 - built];
+            std::size_t signals = SignalRegistry::size();
+            next.states.assign(signals, 0);
+            next.values.assign(signals, Position{});
+        }
+
+        /**
+         * Returns the most recently published snapshot
+         *
+         * @return const ActionSnapshot&
+         */
+        [[nodiscard]] const ActionSnapshot &read() const
+        {
+            return buffers[front.load(std::memory_order_acquire)];
+        }
+
+    private:
+        std::array<ActionSnapshot, 2> buffers;
+
+        std::atomic<unsigned> front{0};
+
+        std::uint64_t frames = 0;
+
+        ActionSnapshot &back()
+        {
+            return buffers[1 - front.load(std::memory_order_relaxed)];
+        }
+
+        /**
+         * Grow the snapshot for signals interned after the previous publish
+         */
+        static void fit(ActionSnapshot &snapshot, SignalId signalId)
+        {
+            if (signalId >= snapshot.states.size()) {
+                snapshot.states.resize(signalId + 1, 0);
+                snapshot.values.resize(signalId + 1, Position{});
+            }
+        }
+
+    };
+
+}
+
+#endif
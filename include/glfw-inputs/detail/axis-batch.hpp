@@ -0,0 +1,202 @@
+#ifndef GLFW_INPUTS_TESTS_AXIS_BATCH_HPP
+#define GLFW_INPUTS_TESTS_AXIS_BATCH_HPP
+
+#include "../axis-filter.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define GLFW_INPUTS_AXIS_BATCH_SSE2
+#endif
+
+namespace GLFW_Inputs {
+
+    /**
+     * Axis Batch
+     *
+     * Structure-of-arrays storage for the axis pairs of many devices
+     * (for example the sticks of all connected joysticks), which are
+     * filtered and compared with the previously dispatched values in
+     * batched passes, using SSE2 where available.
+     *
+     * The result of a pass is the list of pairs which changed, so only
+     * those have to be dispatched.
+     *
+     * Storage is allocated by resize, and not during the passes.
+     */
+    class AxisBatch {
+    public:
+
+        /**
+         * Set the number of axis pairs, and reset all state
+         *
+         * @param std::size_t pairs
+         * @return void
+         */
+        void resize(std::size_t pairs)
+        {
+            rawX.assign(pairs, 0.0);
+            rawY.assign(pairs, 0.0);
+            filteredX.assign(pairs, 0.0);
+            filteredY.assign(pairs, 0.0);
+            lastX.assign(pairs, 0.0);
+            lastY.assign(pairs, 0.0);
+            thresholds.assign(pairs, 0.0);
+            active.assign(pairs, 0);
+            dispatched.assign(pairs, 0);
+            filterStates.assign(pairs, {});
+            changed.clear();
+            changed.reserve(pairs);
+        }
+
+        /**
+         * Start gathering a new batch, where all pairs are inactive until set
+         *
+         * @return void
+         */
+        void begin()
+        {
+            std::fill(active.begin(), active.end(), 0);
+        }
+
+        /**
+         * Set the raw values of a pair, and mark it active in the batch
+         *
+         * @param std::size_t pair
+         * @param double x
+         * @param double y
+         * @param double threshold Changes of at most this amount aren't reported
+         * @return void
+         */
+        void set(std::size_t pair, double x, double y, double threshold)
+        {
+            rawX[pair] = x;
+            rawY[pair] = y;
+            thresholds[pair] = threshold;
+            active[pair] = 1;
+        }
+
+        /**
+         * Filter a range of pairs
+         *
+         * @param std::size_t first
+         * @param std::size_t count
+         * @param const AxisFilter& filter
+         * @param double deltaTime Seconds since the previous batch
+         * @return void
+         */
+        void filter(std::size_t first, std::size_t count, const AxisFilter &filter, double deltaTime)
+        {
+            std::copy(&rawX[first], &rawX[first] + count, &filteredX[first]);
+            std::copy(&rawY[first], &rawY[first] + count, &filteredY[first]);
+            filter.apply(&filterStates[first], &filteredX[first], &filteredY[first], count, deltaTime);
+        }
+
+        /**
+         * Find the active pairs which changed since they were last reported
+         *
+         * A pair is reported the first time it's active, and afterwards
+         * when either axis moved more than the threshold of the pair.
+         * The reported values become the new reference.
+         *
+         * @return const std::vector<std::uint32_t>& Indexes of the changed pairs
+         */
+        const std::vector<std::uint32_t> &detectChanges()
+        {
+            changed.clear();
+
+            std::size_t pair = 0;
+#if defined(GLFW_INPUTS_AXIS_BATCH_SSE2)
+            // Two pairs at a time: |filtered - last| > threshold, for X and Y
+            const __m128d signMask = _mm_set1_pd(-0.0);
+            for (; pair + 2 <= size(); pair += 2) {
+                __m128d threshold = _mm_loadu_pd(&thresholds[pair]);
+                __m128d deltaX = _mm_andnot_pd(signMask, _mm_sub_pd(_mm_loadu_pd(&filteredX[pair]),
+                                                                    _mm_loadu_pd(&lastX[pair])));
+                __m128d deltaY = _mm_andnot_pd(signMask, _mm_sub_pd(_mm_loadu_pd(&filteredY[pair]),
+                                                                    _mm_loadu_pd(&lastY[pair])));
+                int moved = _mm_movemask_pd(_mm_or_pd(_mm_cmpgt_pd(deltaX, threshold),
+                                                      _mm_cmpgt_pd(deltaY, threshold)));
+
+                for (std::size_t lane = 0; lane < 2; lane++) {
+                    if (((moved >> lane) & 1) || !dispatched[pair + lane]) {
+                        report(pair + lane);
+                    }
+                }
+            }
+#endif
+            for (; pair < size(); pair++) {
+                if (std::abs(filteredX[pair] - lastX[pair]) > thresholds[pair]
+                    || std::abs(filteredY[pair] - lastY[pair]) > thresholds[pair]
+                    || !dispatched[pair]) {
+                    report(pair);
+                }
+            }
+
+            return changed;
+        }
+
+        [[nodiscard]] double x(std::size_t pair) const
+        {
+            return filteredX[pair];
+        }
+
+        [[nodiscard]] double y(std::size_t pair) const
+        {
+            return filteredY[pair];
+        }
+
+        /**
+         * Returns true if the pair was set in the current batch
+         *
+         * @param std::size_t pair
+         * @return bool
+         */
+        [[nodiscard]] bool isActive(std::size_t pair) const
+        {
+            return active[pair] != 0;
+        }
+
+        [[nodiscard]] std::size_t size() const
+        {
+            return rawX.size();
+        }
+
+    private:
+        std::vector<double> rawX, rawY;
+
+        std::vector<double> filteredX, filteredY;
+
+        /**
+         * The most recently reported values
+         */
+        std::vector<double> lastX, lastY;
+
+        std::vector<double> thresholds;
+
+        std::vector<unsigned char> active, dispatched;
+
+        std::vector<AxisFilterState> filterStates;
+
+        std::vector<std::uint32_t> changed;
+
+        void report(std::size_t pair)
+        {
+            if (!active[pair]) {
+                return;
+            }
+            lastX[pair] = filteredX[pair];
+            lastY[pair] = filteredY[pair];
+            dispatched[pair] = 1;
+            changed.push_back(static_cast<std::uint32_t>(pair));
+        }
+
+    };
+
+}
+
+#endif
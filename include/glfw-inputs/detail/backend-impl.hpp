@@ -0,0 +1,393 @@
+#ifndef GLFW_INPUTS_TESTS_BACKEND_IMPL_HPP
+#define GLFW_INPUTS_TESTS_BACKEND_IMPL_HPP
+
+#include "../glfw-inputs.hpp"
+#include <mutex>
+
+/**
+ * Definitions of the input backends
+ *
+ * Included by glfw-inputs.hpp, unless GLFW_INPUTS_COMPILED_LIB is defined,
+ * in which case the definitions are compiled once in the library
+ */
+
+namespace GLFW_Inputs {
+
+    /**
+     * All managers attached to a GLFW backend, which is needed because
+     * GLFW's joystick callback isn't associated with a window
+     */
+    struct GlfwBackend::ManagerRegistry {
+        std::mutex mutex;
+        std::vector<Manager *> managers;
+    };
+
+    struct SyntheticBackend::VirtualJoystick {
+        bool present = false;
+        bool gamepad = false;
+        std::string name;
+        std::vector<unsigned char> buttons;
+        std::vector<float> axes;
+        GLFWgamepadstate gamepadState{};
+    };
+
+    struct SyntheticBackend::Impl {
+        std::vector<Manager *> managers;
+
+        std::array<VirtualJoystick, GLFW_JOYSTICK_LAST + 1> joysticks;
+    };
+
+    GLFW_INPUTS_INLINE InputBackend &defaultBackend()
+    {
+        static GlfwBackend backend;
+        return backend;
+    }
+
+    GLFW_INPUTS_INLINE void GlfwBackend::attach(Manager &manager)
+    {
+        {
+            ManagerRegistry &registry = managerRegistry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            registry.managers.push_back(&manager);
+        }
+
+        // Joysticks and gamepads
+        // GLFW only provides a global callback for these, which
+        // is forwarded to every manager
+        glfwSetJoystickCallback(GlfwBackend::joystickConnectionCallback);
+
+        if (!window) {
+            return;
+        }
+
+        glfwSetWindowUserPointer(window, &manager);
+
+        // Keyboard
+        glfwSetKeyCallback(window, GlfwBackend::keyboardCallback);
+
+        // Mouse
+        glfwSetMouseButtonCallback(window, GlfwBackend::mouseButtonCallback);
+        glfwSetCursorPosCallback(window, GlfwBackend::mouseMoveCallback);
+        glfwSetScrollCallback(window, GlfwBackend::mouseWheelCallback);
+    }
+
+    GLFW_INPUTS_INLINE void GlfwBackend::detach(Manager &manager)
+    {
+        {
+            ManagerRegistry &registry = managerRegistry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            registry.managers.erase(std::remove(registry.managers.begin(),
+                                                registry.managers.end(),
+                                                &manager),
+                                    registry.managers.end());
+        }
+
+        if (window && glfwGetWindowUserPointer(window) == &manager) {
+            glfwSetWindowUserPointer(window, nullptr);
+            glfwSetKeyCallback(window, nullptr);
+            glfwSetMouseButtonCallback(window, nullptr);
+            glfwSetCursorPosCallback(window, nullptr);
+            glfwSetScrollCallback(window, nullptr);
+        }
+    }
+
+    GLFW_INPUTS_INLINE bool GlfwBackend::setRawMouseMotion(bool enabled)
+    {
+        if (!window) {
+            return false;
+        }
+
+        // A disabled cursor provides unbounded movement, even
+        // where raw motion isn't supported
+        glfwSetInputMode(window, GLFW_CURSOR, enabled ? GLFW_CURSOR_DISABLED : GLFW_CURSOR_NORMAL);
+
+        if (!glfwRawMouseMotionSupported()) {
+            return false;
+        }
+        glfwSetInputMode(window, GLFW_RAW_MOUSE_MOTION, enabled ? GLFW_TRUE : GLFW_FALSE);
+        return true;
+    }
+
+    GLFW_INPUTS_INLINE void GlfwBackend::joystickConnectionCallback(int jid, int event)
+    {
+        // Handlers run without holding the lock, since they may create or
+        // destroy managers. Managers detached in the meantime are skipped.
+        ManagerRegistry &registry = managerRegistry();
+        std::vector<Manager *> managers;
+        {
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            managers = registry.managers;
+        }
+
+        for (Manager *manager : managers) {
+            {
+                std::lock_guard<std::mutex> lock(registry.mutex);
+                if (std::find(registry.managers.begin(), registry.managers.end(), manager) == registry.managers.end()) {
+                    continue;
+                }
+            }
+            manager->onJoystickConnection(jid, event);
+        }
+    }
+
+    GLFW_INPUTS_INLINE void GlfwBackend::mouseMoveCallback(GLFWwindow *glfwWindow, double x, double y)
+    {
+        if (Manager *manager = fromWindow(glfwWindow)) {
+            manager->onMouseMove(x, y);
+        }
+    }
+
+    GLFW_INPUTS_INLINE void GlfwBackend::mouseWheelCallback(GLFWwindow *glfwWindow, double x, double y)
+    {
+        if (Manager *manager = fromWindow(glfwWindow)) {
+            manager->onMouseWheel(x, y);
+        }
+    }
+
+    GLFW_INPUTS_INLINE void GlfwBackend::mouseButtonCallback(GLFWwindow *window, int button, int action, int mods)
+    {
+        if (Manager *manager = fromWindow(window)) {
+            manager->onMouseButton(button, action, mods);
+        }
+    }
+
+    GLFW_INPUTS_INLINE void GlfwBackend::keyboardCallback(GLFWwindow *window, int key, int scancode, int action, int mods)
+    {
+        if (Manager *manager = fromWindow(window)) {
+            manager->onKeyboard(key, scancode, action, mods);
+        }
+    }
+
+    GLFW_INPUTS_INLINE GlfwBackend::ManagerRegistry &GlfwBackend::managerRegistry()
+    {
+        static ManagerRegistry registry;
+        return registry;
+    }
+
+    GLFW_INPUTS_INLINE Manager *GlfwBackend::fromWindow(GLFWwindow *window)
+    {
+        if (!window) {
+            return nullptr;
+        }
+        return static_cast<Manager *>(glfwGetWindowUserPointer(window));
+    }
+
+    GLFW_INPUTS_INLINE SyntheticBackend::SyntheticBackend() : impl(std::make_unique<Impl>()) { }
+
+    GLFW_INPUTS_INLINE SyntheticBackend::~SyntheticBackend() = default;
+
+    GLFW_INPUTS_INLINE void SyntheticBackend::attach(Manager &manager)
+    {
+        impl->managers.push_back(&manager);
+    }
+
+    GLFW_INPUTS_INLINE void SyntheticBackend::detach(Manager &manager)
+    {
+        impl->managers.erase(std::remove(impl->managers.begin(), impl->managers.end(), &manager),
+                             impl->managers.end());
+    }
+
+    GLFW_INPUTS_INLINE void SyntheticBackend::key(int key, int action, int mods, int scancode)
+    {
+        for (Manager *manager : impl->managers) {
+            manager->onKeyboard(key, scancode, action, mods);
+        }
+    }
+
+    GLFW_INPUTS_INLINE void SyntheticBackend::mouseButton(int button, int action, int mods)
+    {
+        for (Manager *manager : impl->managers) {
+            manager->onMouseButton(button, action, mods);
+        }
+    }
+
+    GLFW_INPUTS_INLINE void SyntheticBackend::cursor(double x, double y)
+    {
+        for (Manager *manager : impl->managers) {
+            manager->onMouseMove(x, y);
+        }
+    }
+
+    GLFW_INPUTS_INLINE void SyntheticBackend::scroll(double x, double y)
+    {
+        for (Manager *manager : impl->managers) {
+            manager->onMouseWheel(x, y);
+        }
+    }
+
+    GLFW_INPUTS_INLINE bool SyntheticBackend::joystickPresent(int jid)
+    {
+        VirtualJoystick *joystick = find(jid);
+        return joystick && joystick->present;
+    }
+
+    GLFW_INPUTS_INLINE const char *SyntheticBackend::joystickName(int jid)
+    {
+        VirtualJoystick *joystick = find(jid);
+        return joystick && joystick->present ? joystick->name.c_str() : nullptr;
+    }
+
+    GLFW_INPUTS_INLINE const char *SyntheticBackend::gamepadName(int jid)
+    {
+        VirtualJoystick *joystick = find(jid);
+        return joystick && joystick->present && joystick->gamepad ? joystick->name.c_str() : nullptr;
+    }
+
+    GLFW_INPUTS_INLINE void SyntheticBackend::connectJoystick(int jid,
+                                                              const std::string &name,
+                                                              int buttonCount,
+                                                              int axisCount,
+                                                              bool gamepad)
+    {
+        VirtualJoystick *joystick = find(jid);
+        if (!joystick) {
+            return;
+        }
+
+        joystick->present = true;
+        joystick->gamepad = gamepad;
+        joystick->name = name;
+        joystick->buttons.assign(buttonCount, GLFW_RELEASE);
+        joystick->axes.assign(axisCount, 0.0f);
+        joystick->gamepadState = {};
+
+        // Released triggers, as reported by GLFW
+        joystick->gamepadState.axes[GLFW_GAMEPAD_AXIS_LEFT_TRIGGER] = -1.0f;
+        joystick->gamepadState.axes[GLFW_GAMEPAD_AXIS_RIGHT_TRIGGER] = -1.0f;
+
+        for (Manager *manager : impl->managers) {
+            manager->onJoystickConnection(jid, GLFW_CONNECTED);
+        }
+    }
+
+    GLFW_INPUTS_INLINE void SyntheticBackend::disconnectJoystick(int jid)
+    {
+        VirtualJoystick *joystick = find(jid);
+        if (!joystick || !joystick->present) {
+            return;
+        }
+
+        joystick->present = false;
+
+        for (Manager *manager : impl->managers) {
+            manager->onJoystickConnection(jid, GLFW_DISCONNECTED);
+        }
+    }
+
+    GLFW_INPUTS_INLINE void SyntheticBackend::setJoystickPresent(int jid, bool present, const std::string &name)
+    {
+        VirtualJoystick *joystick = find(jid);
+        if (!joystick) {
+            return;
+        }
+
+        joystick->present = present;
+        if (present) {
+            joystick->gamepad = false;
+            joystick->name = name;
+        }
+    }
+
+    GLFW_INPUTS_INLINE void SyntheticBackend::setJoystickState(int jid,
+                                                               const unsigned char *buttons,
+                                                               int buttonCount,
+                                                               const float *axes,
+                                                               int axisCount)
+    {
+        VirtualJoystick *joystick = find(jid);
+        if (!joystick) {
+            return;
+        }
+
+        joystick->present = true;
+        joystick->buttons.assign(buttons, buttons + buttonCount);
+        joystick->axes.assign(axes, axes + axisCount);
+    }
+
+    GLFW_INPUTS_INLINE void SyntheticBackend::setGamepadState(int jid, const GLFWgamepadstate &state)
+    {
+        VirtualJoystick *joystick = find(jid);
+        if (!joystick) {
+            return;
+        }
+
+        joystick->present = true;
+        joystick->gamepad = true;
+        joystick->gamepadState = state;
+    }
+
+    GLFW_INPUTS_INLINE void SyntheticBackend::setJoystickButton(int jid, int button, bool pressed)
+    {
+        VirtualJoystick *joystick = find(jid);
+        if (joystick && button >= 0 && button < static_cast<int>(joystick->buttons.size())) {
+            joystick->buttons[button] = pressed ? GLFW_PRESS : GLFW_RELEASE;
+        }
+    }
+
+    GLFW_INPUTS_INLINE void SyntheticBackend::setJoystickAxis(int jid, int axis, float value)
+    {
+        VirtualJoystick *joystick = find(jid);
+        if (joystick && axis >= 0 && axis < static_cast<int>(joystick->axes.size())) {
+            joystick->axes[axis] = value;
+        }
+    }
+
+    GLFW_INPUTS_INLINE void SyntheticBackend::setGamepadButton(int jid, int button, bool pressed)
+    {
+        VirtualJoystick *joystick = find(jid);
+        if (joystick && button >= 0 && button <= GLFW_GAMEPAD_BUTTON_LAST) {
+            joystick->gamepadState.buttons[button] = pressed ? GLFW_PRESS : GLFW_RELEASE;
+        }
+    }
+
+    GLFW_INPUTS_INLINE void SyntheticBackend::setGamepadAxis(int jid, int axis, float value)
+    {
+        VirtualJoystick *joystick = find(jid);
+        if (joystick && axis >= 0 && axis <= GLFW_GAMEPAD_AXIS_LAST) {
+            joystick->gamepadState.axes[axis] = value;
+        }
+    }
+
+    GLFW_INPUTS_INLINE const unsigned char *SyntheticBackend::joystickButtons(int jid, int *count)
+    {
+        VirtualJoystick *joystick = find(jid);
+        if (!joystick || !joystick->present) {
+            *count = 0;
+            return nullptr;
+        }
+        *count = static_cast<int>(joystick->buttons.size());
+        return joystick->buttons.data();
+    }
+
+    GLFW_INPUTS_INLINE const float *SyntheticBackend::joystickAxes(int jid, int *count)
+    {
+        VirtualJoystick *joystick = find(jid);
+        if (!joystick || !joystick->present) {
+            *count = 0;
+            return nullptr;
+        }
+        *count = static_cast<int>(joystick->axes.size());
+        return joystick->axes.data();
+    }
+
+    GLFW_INPUTS_INLINE bool SyntheticBackend::gamepadState(int jid, GLFWgamepadstate *state)
+    {
+        VirtualJoystick *joystick = find(jid);
+        if (!joystick || !joystick->present || !joystick->gamepad) {
+            return false;
+        }
+        *state = joystick->gamepadState;
+        return true;
+    }
+
+    GLFW_INPUTS_INLINE SyntheticBackend::VirtualJoystick *SyntheticBackend::find(int jid)
+    {
+        if (jid < 0 || jid > GLFW_JOYSTICK_LAST) {
+            return nullptr;
+        }
+        return &impl->joysticks[jid];
+    }
+
+}
+
+#endif
@@ -0,0 +1,257 @@
+#ifndef GLFW_INPUTS_TESTS_COMBO_AUTOMATON_HPP
+#define GLFW_INPUTS_TESTS_COMBO_AUTOMATON_HPP
+
+#include "../glfw-inputs.hpp"
+#include <algorithm>
+#include <atomic>
+#include <unordered_map>
+
+namespace GLFW_Inputs {
+
+    /**
+     * Combo Automaton
+     *
+     * Recognizes chords (inputs held together) and sequences (steps pressed
+     * in order within a time window). All combos of a mapping are compiled
+     * into a trie, where each edge is a step, and each step is a set of
+     * inputs which must all be held.
+     *
+     * Each control keeps its own list of active states (positions in the
+     * trie). A button press advances only these states, and starts new
+     * ones from the edges of the root which contain the pressed input, so
+     * the work per press doesn't depend on the number of combos.
+     *
+     * The states are only valid in the trie which created them, so they
+     * record the automaton and its generation, which changes with every
+     * added combo.
+     *
+     * @see https://glfw-inputs.readthedocs.io/en/latest/controls/combos/
+     */
+    class ComboAutomaton {
+    public:
+
+        using State = ComboState;
+
+        using States = ComboStates;
+
+        /**
+         * A combo ending in a node
+         */
+        struct Match {
+            std::string signal;
+            SignalId signalId;
+            Clock::duration window;
+        };
+
+        ComboAutomaton()
+        {
+            nodes.emplace_back();
+        }
+
+        /**
+         * Add a combo
+         *
+         * @param const std::vector<std::vector<Input>>& steps
+         * @param const std::string& signal
+         * @param Clock::duration window Maximum time from the first to the last step
+         * @return void
+         */
+        void add(const std::vector<std::vector<Input>> &steps, const std::string &signal, Clock::duration window)
+        {
+            std::uint32_t node = 0;
+            nodes[node].window = std::max(nodes[node].window, window);
+
+            for (std::vector<Input> step : steps) {
+                std::sort(step.begin(), step.end());
+                step.erase(std::unique(step.begin(), step.end()), step.end());
+
+                std::optional<std::uint32_t> target;
+                for (std::uint32_t e : nodes[node].children) {
+                    if (edges[e].step == step) {
+                        target = edges[e].target;
+                        break;
+                    }
+                }
+
+                if (!target.has_value()) {
+                    target = static_cast<std::uint32_t>(nodes.size());
+                    auto edge = static_cast<std::uint32_t>(edges.size());
+                    nodes.emplace_back();
+                    edges.push_back({step, target.value()});
+                    nodes[node].children.push_back(edge);
+
+                    if (node == 0) {
+                        for (Input input : step) {
+                            rootEdges[input].push_back(edge);
+                        }
+                    }
+                }
+
+                node = target.value();
+                nodes[node].window = std::max(nodes[node].window, window);
+            }
+
+            nodes[node].matches.push_back({signal, SignalRegistry::intern(signal), window});
+            generation = nextGeneration.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /**
+         * Returns the generation of the trie
+         *
+         * Unique across automata, and changed by every added combo
+         *
+         * @return std::uint32_t
+         */
+        [[nodiscard]] std::uint32_t getGeneration() const
+        {
+            return generation;
+        }
+
+        /**
+         * Returns true if the states were created in this automaton,
+         * in its current generation
+         *
+         * @param const States& states
+         * @return bool
+         */
+        [[nodiscard]] bool owns(const States &states) const
+        {
+            return states.owner == this && states.generation == generation;
+        }
+
+        /**
+         * Advance the states of a control on a button press
+         *
+         * @param States& states The states of the control
+         * @param Input input The pressed input
+         * @param Timestamp timestamp
+         * @param IsDown isDown Returns true if the given input is held
+         * @param OnMatch onMatch Invoked with each matched Match
+         * @return void
+         */
+        template<typename IsDown, typename OnMatch>
+        void advance(States &states, Input input, Timestamp timestamp, IsDown isDown, OnMatch onMatch) const
+        {
+            if (edges.empty()) {
+                return;
+            }
+            states.next.clear();
+
+            for (const State &state : states.active) {
+                const Node &node = nodes[state.node];
+                if (timestamp - state.start > node.window) {
+                    continue;
+                }
+
+                bool advanced = false, partial = false;
+                for (std::uint32_t e : node.children) {
+                    const Edge &edge = edges[e];
+                    if (!std::binary_search(edge.step.begin(), edge.step.end(), input)) {
+                        continue;
+                    }
+                    partial = true;
+                    if (std::all_of(edge.step.begin(), edge.step.end(), isDown)) {
+                        enter(states, {edge.target, state.start}, timestamp, onMatch);
+                        advanced = true;
+                    }
+                }
+
+                // A press which is part of the next step (such as the first
+                // input of a chord) keeps the state alive, other presses break it
+                if (!advanced && partial) {
+                    keep(states, state);
+                }
+            }
+
+            auto root = rootEdges.find(input);
+            if (root != rootEdges.end()) {
+                for (std::uint32_t e : root->second) {
+                    const Edge &edge = edges[e];
+                    if (std::all_of(edge.step.begin(), edge.step.end(), isDown)) {
+                        enter(states, {edge.target, timestamp}, timestamp, onMatch);
+                    }
+                }
+            }
+
+            std::swap(states.active, states.next);
+        }
+
+        /**
+         * Returns true if no combos are registered
+         *
+         * @return bool
+         */
+        [[nodiscard]] bool empty() const
+        {
+            return edges.empty();
+        }
+
+    private:
+        struct Node {
+            std::vector<std::uint32_t> children;
+            std::vector<Match> matches;
+
+            /**
+             * The longest window of the combos passing through the node,
+             * after which states in the node can't match anymore
+             */
+            Clock::duration window = Clock::duration::zero();
+        };
+
+        struct Edge {
+            std::vector<Input> step;
+            std::uint32_t target;
+        };
+
+        std::vector<Node> nodes;
+
+        std::vector<Edge> edges;
+
+        /**
+         * Edges from the root, by the inputs of their step
+         */
+        std::unordered_map<int, std::vector<std::uint32_t>> rootEdges;
+
+        std::uint32_t generation = 0;
+
+        /**
+         * Shared by all automata, so a trie allocated where another one
+         * was destroyed doesn't take over its states
+         */
+        static inline std::atomic<std::uint32_t> nextGeneration{1};
+
+        template<typename OnMatch>
+        void enter(States &states, State state, Timestamp timestamp, OnMatch onMatch) const
+        {
+            const Node &node = nodes[state.node];
+            for (const Match &match : node.matches) {
+                if (timestamp - state.start <= match.window) {
+                    onMatch(match);
+                }
+            }
+
+            if (!node.children.empty()) {
+                keep(states, state);
+            }
+        }
+
+        /**
+         * Keep a state for the next press, once per node
+         * (the latest start, which has the most time left)
+         */
+        static void keep(States &states, State state)
+        {
+            for (State &existing : states.next) {
+                if (existing.node == state.node) {
+                    existing.start = std::max(existing.start, state.start);
+                    return;
+                }
+            }
+            states.next.push_back(state);
+        }
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,316 @@
+#ifndef GLFW_INPUTS_TESTS_CONTROLS_IMPL_HPP
+#define GLFW_INPUTS_TESTS_CONTROLS_IMPL_HPP
+
+#include "../glfw-inputs.hpp"
+#include "combo-automaton.hpp"
+#include <cmath>
+
+/**
+ * Definitions of ControlMapping, MappingContextStack, MotionControl and AxisFilter
+ *
+ * Included by glfw-inputs.hpp, unless GLFW_INPUTS_COMPILED_LIB is defined,
+ * in which case the definitions are compiled once in the library
+ */
+
+namespace GLFW_Inputs {
+
+    GLFW_INPUTS_INLINE ControlMapping::ControlMapping()
+    {
+        lookup.fill(unmapped);
+    }
+
+    GLFW_INPUTS_INLINE ControlMapping::ControlMapping(const ControlMapping &other)
+        : Messaging(other),
+          mappedInputEvents(other.mappedInputEvents),
+          mappedDeviceEvents(other.mappedDeviceEvents),
+          combos(other.combos ? std::make_unique<ComboAutomaton>(*other.combos) : nullptr),
+          lookup(other.lookup),
+          modifierLookup(other.modifierLookup),
+          scancodeLookup(other.scancodeLookup) { }
+
+    GLFW_INPUTS_INLINE ControlMapping::ControlMapping(ControlMapping &&other) noexcept = default;
+
+    GLFW_INPUTS_INLINE ControlMapping &ControlMapping::operator=(const ControlMapping &other)
+    {
+        if (this != &other) {
+            mappedInputEvents = other.mappedInputEvents;
+            mappedDeviceEvents = other.mappedDeviceEvents;
+            combos = other.combos ? std::make_unique<ComboAutomaton>(*other.combos) : nullptr;
+            lookup = other.lookup;
+            modifierLookup = other.modifierLookup;
+            scancodeLookup = other.scancodeLookup;
+        }
+        return *this;
+    }
+
+    GLFW_INPUTS_INLINE ControlMapping &ControlMapping::operator=(ControlMapping &&other) noexcept = default;
+
+    GLFW_INPUTS_INLINE ControlMapping::~ControlMapping() = default;
+
+    GLFW_INPUTS_INLINE void ControlMapping::onSequence(const std::vector<std::vector<Input>> &steps,
+                                                       std::string signal,
+                                                       Clock::duration window)
+    {
+        if (!isValidSignalName(signal)) {
+            error("Signal name not compliant: " + signal);
+        }
+
+        for (const std::vector<Input> &step : steps) {
+            for (Input input : step) {
+                if (input < 0 || input >= static_cast<int>(inputCount)) {
+                    error("Input out of range: " + std::to_string(input));
+                    return;
+                }
+            }
+            if (step.empty()) {
+                error("Empty step in sequence: " + signal);
+                return;
+            }
+        }
+
+        if (!combos) {
+            combos = std::make_unique<ComboAutomaton>();
+        }
+        combos->add(steps, signal, window);
+    }
+
+    GLFW_INPUTS_INLINE const ComboAutomaton &ControlMapping::getCombos() const
+    {
+        static const ComboAutomaton none;
+        return combos ? *combos : none;
+    }
+
+    GLFW_INPUTS_INLINE void MappingContextStack::push(ControlMapping &mapping, int priority, ContextMode mode)
+    {
+        if (count == capacity) {
+            error("Too many mapping contexts (at most " + std::to_string(capacity) + ")");
+            return;
+        }
+        if (!mapping.getCombos().empty()) {
+            error("Mapping contexts can't have chords or sequences");
+            return;
+        }
+
+        std::size_t position = 0;
+        while (position < count && contexts[position].priority > priority) {
+            position++;
+        }
+        for (std::size_t i = count; i > position; i--) {
+            contexts[i] = contexts[i - 1];
+        }
+        contexts[position] = {
+            .mapping = &mapping,
+            .priority = priority,
+            .mode = mode,
+            .order = nextOrder++,
+        };
+        count++;
+
+        compile();
+    }
+
+    GLFW_INPUTS_INLINE bool MappingContextStack::pop()
+    {
+        if (count == 0) {
+            return false;
+        }
+
+        std::size_t latest = 0;
+        for (std::size_t i = 1; i < count; i++) {
+            if (contexts[i].order > contexts[latest].order) {
+                latest = i;
+            }
+        }
+        erase(latest);
+        return true;
+    }
+
+    GLFW_INPUTS_INLINE bool MappingContextStack::remove(const ControlMapping &mapping)
+    {
+        bool removed = false;
+        for (std::size_t i = count; i > 0; i--) {
+            if (contexts[i - 1].mapping == &mapping) {
+                erase(i - 1);
+                removed = true;
+            }
+        }
+        return removed;
+    }
+
+    GLFW_INPUTS_INLINE bool MappingContextStack::replace(const ControlMapping &from, ControlMapping &to)
+    {
+        bool replaced = false;
+        for (std::size_t i = 0; i < count; i++) {
+            if (contexts[i].mapping == &from) {
+                contexts[i].mapping = &to;
+                replaced = true;
+            }
+        }
+        if (replaced) {
+            compile();
+        }
+        return replaced;
+    }
+
+    GLFW_INPUTS_INLINE void MappingContextStack::clear()
+    {
+        count = 0;
+        compile();
+    }
+
+    GLFW_INPUTS_INLINE void MappingContextStack::compile()
+    {
+        table.fill(0);
+        scancodeContexts = 0;
+
+        for (std::size_t i = 0; i < count; i++) {
+            const ControlMapping &mapping = *contexts[i].mapping;
+            auto bit = static_cast<std::uint16_t>(1u << i);
+
+            for (std::size_t event = 0; event < eventCount; event++) {
+                for (std::size_t input = 0; input < inputCount; input++) {
+                    if (mapping.maps(static_cast<Event>(event), static_cast<Input>(input))) {
+                        table[event * inputCount + input] |= bit;
+                    }
+                }
+            }
+            if (mapping.hasScancodes()) {
+                scancodeContexts |= bit;
+            }
+            if (!mapping.getCombos().empty()) {
+                error("Chords and sequences of mapping contexts are ignored");
+            }
+        }
+    }
+
+    GLFW_INPUTS_INLINE void MappingContextStack::erase(std::size_t position)
+    {
+        for (std::size_t i = position; i + 1 < count; i++) {
+            contexts[i] = contexts[i + 1];
+        }
+        count--;
+        compile();
+    }
+
+    GLFW_INPUTS_INLINE Position MotionControl::axesChanged(Position position, MotionSurface surface, Timestamp timestamp)
+    {
+        if (!mapping.has_value()) {
+            return position;
+        }
+
+        AxisFilter filter = mapping.value()->axisFilter;
+        if (surface == MotionSurface::GamepadTriggers && filter.deadzone == Deadzone::Radial) {
+            filter.deadzone = Deadzone::Axial;
+        }
+        auto index = static_cast<std::size_t>(surface);
+
+        double deltaTime = filterStates[index].initialized
+            ? std::chrono::duration<double>(timestamp - filterTimes[index]).count()
+            : 0.0;
+        filterTimes[index] = timestamp;
+        filter.apply(&filterStates[index], &position.x, &position.y, 1, deltaTime);
+
+        const SurfaceState &state = surfaces[index];
+        if (state.valid
+            && std::abs(position.x - state.last.x) <= filter.threshold
+            && std::abs(position.y - state.last.y) <= filter.threshold) {
+            return position;
+        }
+
+        positionChanged(position, surface, timestamp);
+        return position;
+    }
+
+    GLFW_INPUTS_INLINE void AxisFilter::apply(AxisFilterState *states, double *x, double *y, std::size_t count, double deltaTime) const
+    {
+        applyDeadzone(x, y, count);
+        applyCurve(x, count);
+        applyCurve(y, count);
+        applySmoothing(states, x, y, count, deltaTime);
+    }
+
+    GLFW_INPUTS_INLINE void AxisFilter::applyDeadzone(double *x, double *y, std::size_t count) const
+    {
+        double range = std::max(1.0 - innerDeadzone - outerDeadzone, 1e-9);
+
+        switch (deadzone) {
+            case Deadzone::None:
+                break;
+            case Deadzone::Axial:
+                for (std::size_t i = 0; i < count; i++) {
+                    x[i] = std::copysign(rescale(std::abs(x[i]), range), x[i]);
+                    y[i] = std::copysign(rescale(std::abs(y[i]), range), y[i]);
+                }
+                break;
+            case Deadzone::Radial:
+                for (std::size_t i = 0; i < count; i++) {
+                    double magnitude = std::sqrt(x[i] * x[i] + y[i] * y[i]);
+                    double scale = magnitude > 0.0 ? rescale(magnitude, range) / magnitude : 0.0;
+                    x[i] *= scale;
+                    y[i] *= scale;
+                }
+                break;
+        }
+    }
+
+    GLFW_INPUTS_INLINE void AxisFilter::applyCurve(double *values, std::size_t count) const
+    {
+        if (exponent == 1.0) {
+            return;
+        }
+        for (std::size_t i = 0; i < count; i++) {
+            values[i] = std::copysign(std::pow(std::abs(values[i]), exponent), values[i]);
+        }
+    }
+
+    GLFW_INPUTS_INLINE void AxisFilter::applySmoothing(AxisFilterState *states,
+                                                       double *x,
+                                                       double *y,
+                                                       std::size_t count,
+                                                       double deltaTime) const
+    {
+        if (smoothing == Smoothing::None) {
+            return;
+        }
+
+        for (std::size_t i = 0; i < count; i++) {
+            AxisFilterState &state = states[i];
+            if (!state.initialized || deltaTime <= 0.0) {
+                state = {.x = x[i], .y = y[i], .initialized = true};
+                continue;
+            }
+
+            if (smoothing == Smoothing::Exponential) {
+                state.x += smoothingFactor * (x[i] - state.x);
+                state.y += smoothingFactor * (y[i] - state.y);
+            } else {
+                // One-euro filter: a low-pass filter whose cutoff
+                // rises with the (smoothed) speed of the movement
+                double derivativeAlpha = alpha(derivativeCutoff, deltaTime);
+                state.derivativeX += derivativeAlpha * ((x[i] - state.x) / deltaTime - state.derivativeX);
+                state.derivativeY += derivativeAlpha * ((y[i] - state.y) / deltaTime - state.derivativeY);
+
+                state.x += alpha(minCutoff + beta * std::abs(state.derivativeX), deltaTime) * (x[i] - state.x);
+                state.y += alpha(minCutoff + beta * std::abs(state.derivativeY), deltaTime) * (y[i] - state.y);
+            }
+
+            x[i] = state.x;
+            y[i] = state.y;
+        }
+    }
+
+    GLFW_INPUTS_INLINE double AxisFilter::rescale(double magnitude, double range) const
+    {
+        return std::clamp((magnitude - innerDeadzone) / range, 0.0, 1.0);
+    }
+
+    GLFW_INPUTS_INLINE double AxisFilter::alpha(double cutoff, double deltaTime)
+    {
+        constexpr double pi = 3.14159265358979323846;
+        double tau = 1.0 / (2.0 * pi * cutoff);
+        return 1.0 / (1.0 + tau / deltaTime);
+    }
+
+}
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef GLFW_INPUTS_TESTS_DEVICE_POLL_BUFFER_HPP
+#define GLFW_INPUTS_TESTS_DEVICE_POLL_BUFFER_HPP
+
+#include "../glfw-inputs.hpp"
+#include <array>
+#include <atomic>
+#include <vector>
+
+namespace GLFW_Inputs {
+
+    /**
+     * Device Poll
+     *
+     * The state of the joysticks and gamepads of a manager, as read
+     * by Manager::poll, in the order they were set on the manager
+     */
+    struct DevicePoll {
+        struct JoystickState {
+            bool connected = false;
+            std::vector<unsigned char> buttons;
+            std::vector<float> axes;
+        };
+
+        struct GamepadState {
+            bool connected = false;
+            GLFWgamepadstate state{};
+        };
+
+        std::vector<JoystickState> joysticks;
+        std::vector<GamepadState> gamepads;
+    };
+
+    /**
+     * Device Poll Buffer
+     *
+     * Triple buffer of DevicePolls: the thread polling events writes one,
+     * the thread ticking the manager reads another, and the third holds
+     * the latest published poll. Neither thread waits for the other, and
+     * a poll published before the previous one was read replaces it.
+     */
+    class DevicePollBuffer {
+    public:
+
+        /**
+         * The poll being written (polling thread)
+         *
+         * Its vectors keep their capacity, so polling doesn't allocate
+         * after the first polls
+         *
+         * @return DevicePoll&
+         */
+        DevicePoll &back()
+        {
+            return buffers[writing];
+        }
+
+        /**
+         * Publish the poll being written, and start writing the next one (polling thread)
+         *
+         * @return void
+         */
+        void publish()
+        {
+            writing = latest.exchange(writing | fresh, std::memory_order_acq_rel) & index;
+        }
+
+        /**
+         * Returns the most recently published poll (ticking thread)
+         *
+         * The poll returned before must no longer be read once this is called.
+         *
+         * @return const DevicePoll& Empty until the first poll is published
+         */
+        const DevicePoll &read()
+        {
+            if (latest.load(std::memory_order_relaxed) & fresh) {
+                reading = latest.exchange(reading, std::memory_order_acq_rel) & index;
+            }
+            return buffers[reading];
+        }
+
+    private:
+        /**
+         * The index of the latest buffer, with the fresh bit set
+         * until it's read
+         */
+        static constexpr unsigned index = 3;
+        static constexpr unsigned fresh = 4;
+
+        std::array<DevicePoll, 3> buffers;
+
+        unsigned writing = 0;
+        unsigned reading = 1;
+
+        std::atomic<unsigned> latest{2};
+
+    };
+
+}
+
+#endif
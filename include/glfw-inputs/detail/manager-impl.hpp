@@ -0,0 +1,954 @@
+#ifndef GLFW_INPUTS_TESTS_MANAGER_IMPL_HPP
+#define GLFW_INPUTS_TESTS_MANAGER_IMPL_HPP
+
+#include "../glfw-inputs.hpp"
+#include "action-snapshot-buffer.hpp"
+#include "axis-batch.hpp"
+#include "combo-automaton.hpp"
+#include "device-poll-buffer.hpp"
+#include "mapping-context-stack.hpp"
+#include "ring-buffer.hpp"
+#include "signal-listeners.hpp"
+#include <atomic>
+
+/**
+ * Definitions of Manager
+ *
+ * Included by glfw-inputs.hpp, unless GLFW_INPUTS_COMPILED_LIB is defined,
+ * in which case the definitions are compiled once in the library
+ */
+
+namespace GLFW_Inputs {
+
+    struct Manager::Impl {
+        SignalListeners listeners;
+
+        RingBuffer<RawInput> queue;
+        std::atomic<std::size_t> dropped{0};
+
+        /**
+         * The names of the joysticks of the queued connections, in the same order,
+         * as GLFW only allows them to be read on the main thread
+         */
+        RingBuffer<std::string> deviceNames;
+        std::string deviceName;
+
+        static constexpr std::size_t deviceNameCapacity = 64;
+
+        DevicePollBuffer devicePolls;
+
+        ActionSnapshotBuffer actionSnapshots;
+
+        /**
+         * Motion accumulated for the next tick, in coalesced motion mode
+         */
+        struct PendingMotion {
+            bool pending = false;
+            Position position{};
+            Timestamp timestamp;
+            std::vector<MotionSample> samples;
+
+            void add(Position sample, Timestamp sampleTimestamp, bool keepSample)
+            {
+                pending = true;
+                timestamp = sampleTimestamp;
+                if (keepSample) {
+                    samples.push_back({sample, sampleTimestamp});
+                }
+            }
+
+            [[nodiscard]] MotionSamples view() const
+            {
+                return {samples.data(), samples.size()};
+            }
+
+            void reset()
+            {
+                pending = false;
+                position = {};
+                // Keeps the capacity, so samples don't allocate after the first ticks
+                samples.clear();
+            }
+        };
+
+        PendingMotion pendingCursor, pendingWheel;
+
+        /**
+         * Axes of the joysticks, two pairs (movement and rotation) per joystick
+         */
+        AxisBatch joystickAxes;
+    };
+
+    GLFW_INPUTS_INLINE Manager::Manager(GLFWwindow *window)
+        : impl(std::make_unique<Impl>()),
+          ownedBackend(std::make_unique<GlfwBackend>(window)),
+          backend(ownedBackend.get())
+    {
+        backend->attach(*this);
+    }
+
+    GLFW_INPUTS_INLINE Manager::Manager(InputBackend &backend) : impl(std::make_unique<Impl>()), backend(&backend)
+    {
+        backend.attach(*this);
+    }
+
+    GLFW_INPUTS_INLINE Manager::~Manager()
+    {
+        backend->detach(*this);
+    }
+
+    GLFW_INPUTS_INLINE void Manager::setBuffered(bool enabled, std::size_t capacity)
+    {
+        buffered = enabled;
+        impl->queue.reserve(enabled ? capacity : 0);
+        impl->deviceNames.reserve(enabled ? Impl::deviceNameCapacity : 0);
+    }
+
+    GLFW_INPUTS_INLINE const ActionSnapshot &Manager::getActionSnapshot() const
+    {
+        return impl->actionSnapshots.read();
+    }
+
+    GLFW_INPUTS_INLINE void Manager::setJoysticks(const std::vector<Joystick*>& to)
+    {
+        joysticks = to;
+        impl->joystickAxes.resize(joysticks.size() * 2);
+        previousJoystickTick.reset();
+    }
+
+    GLFW_INPUTS_INLINE Subscription Manager::listenFor(const std::string& signal, SignalHandler callback)
+    {
+        return impl->listeners.subscribe(SignalRegistry::intern(signal), std::move(callback));
+    }
+
+    GLFW_INPUTS_INLINE bool Manager::unlisten(Subscription subscription)
+    {
+        return impl->listeners.unsubscribe(subscription);
+    }
+
+    GLFW_INPUTS_INLINE void Manager::onJoystickConnection(int jid, int event)
+    {
+        submit({
+            .type = RawInputType::JoystickConnection,
+            .code = jid,
+            .action = event,
+            .timestamp = Clock::now(),
+        }, backend->joystickName(jid));
+    }
+
+    GLFW_INPUTS_INLINE void Manager::onMouseMove(double x, double y)
+    {
+        submit({
+            .type = RawInputType::MouseMove,
+            .x = x,
+            .y = y,
+            .timestamp = Clock::now(),
+        });
+    }
+
+    GLFW_INPUTS_INLINE void Manager::onMouseWheel(double x, double y)
+    {
+        submit({
+            .type = RawInputType::MouseWheel,
+            .x = x,
+            .y = y,
+            .timestamp = Clock::now(),
+        });
+    }
+
+    GLFW_INPUTS_INLINE void Manager::onMouseButton(int button, int action, int mods)
+    {
+        submit({
+            .type = RawInputType::MouseButton,
+            .code = button,
+            .action = action,
+            .mods = mods,
+            .timestamp = Clock::now(),
+        });
+    }
+
+    GLFW_INPUTS_INLINE void Manager::onKeyboard(int key, int scancode, int action, int mods)
+    {
+        submit({
+            .type = RawInputType::Keyboard,
+            .code = key,
+            .scancode = scancode,
+            .action = action,
+            .mods = mods,
+            .timestamp = Clock::now(),
+        });
+    }
+
+    GLFW_INPUTS_INLINE void Manager::submit(const RawInput &rawInput, const char *deviceName)
+    {
+        if (!buffered) {
+            process(rawInput, deviceName);
+            return;
+        }
+
+        // The name is queued first, so it's there when the connection is drained
+        if (rawInput.type == RawInputType::JoystickConnection
+            && (impl->queue.full() || !impl->deviceNames.push(deviceName ? deviceName : ""))) {
+            impl->dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        if (!impl->queue.push(rawInput)) {
+            impl->dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    GLFW_INPUTS_INLINE void Manager::process(const RawInput &rawInput, const char *deviceName)
+    {
+        if (recorder) {
+            recorder->recordInput(rawInput, deviceName);
+        }
+
+        switch (rawInput.type) {
+            case RawInputType::Keyboard:
+                processKeyboard(rawInput.code, rawInput.scancode, rawInput.action, rawInput.mods, rawInput.timestamp);
+                break;
+            case RawInputType::MouseButton:
+                processMouseButton(rawInput.code, rawInput.action, rawInput.mods, rawInput.timestamp);
+                break;
+            case RawInputType::MouseMove:
+                processMouseMove(rawInput.x, rawInput.y, rawInput.timestamp);
+                break;
+            case RawInputType::MouseWheel:
+                processMouseWheel(rawInput.x, rawInput.y, rawInput.timestamp);
+                break;
+            case RawInputType::JoystickConnection:
+                processJoystickConnection(rawInput.code, rawInput.action, rawInput.timestamp);
+                break;
+        }
+    }
+
+    GLFW_INPUTS_INLINE void Manager::poll()
+    {
+        if (!buffered) {
+            return;
+        }
+
+        DevicePoll &devicePoll = impl->devicePolls.back();
+
+        devicePoll.joysticks.resize(joysticks.size());
+        for (std::size_t i = 0; i < joysticks.size(); i++) {
+            DevicePoll::JoystickState &joystickState = devicePoll.joysticks[i];
+            joystickState.connected = joysticks[i]->isConnected();
+
+            int count = 0;
+            const unsigned char *buttons = joystickState.connected ? joysticks[i]->readButtons(&count) : nullptr;
+            joystickState.buttons.assign(buttons, buttons ? buttons + count : buttons);
+
+            const float *axes = joystickState.connected ? joysticks[i]->readAxes(&count) : nullptr;
+            joystickState.axes.assign(axes, axes ? axes + count : axes);
+        }
+
+        devicePoll.gamepads.resize(gamepads.size());
+        for (std::size_t i = 0; i < gamepads.size(); i++) {
+            DevicePoll::GamepadState &gamepadState = devicePoll.gamepads[i];
+            gamepadState.connected = gamepads[i]->readState(&gamepadState.state);
+        }
+
+        impl->devicePolls.publish();
+    }
+
+    GLFW_INPUTS_INLINE void Manager::drain()
+    {
+        RawInput rawInput;
+        while (impl->queue.pop(rawInput)) {
+            bool named = rawInput.type == RawInputType::JoystickConnection
+                && impl->deviceNames.pop(impl->deviceName);
+            process(rawInput, named ? impl->deviceName.c_str() : nullptr);
+        }
+
+        std::size_t count = impl->dropped.exchange(0, std::memory_order_relaxed);
+        if (count > 0) {
+            warn("Input queue overflow, inputs dropped: " + std::to_string(count));
+        }
+    }
+
+    GLFW_INPUTS_INLINE void Manager::processJoystickConnection([[maybe_unused]] int jid, int event, Timestamp timestamp)
+    {
+        std::optional<DeviceEvent> ev;
+        if (event == GLFW_CONNECTED) {
+            ev = DeviceEvent::Connected;
+        } else if (event == GLFW_DISCONNECTED) {
+            ev = DeviceEvent::Disconnected;
+        }
+
+        if (!ev.has_value()) {
+            return;
+        }
+
+        for (Joystick* joystick : joysticks) {
+            if (!joystick->mapping.has_value()) {
+                continue;
+            }
+
+            handleMappedDeviceEvent(joystick->mapping.value()->find(ev.value()),
+                                    joystick,
+                                    timestamp);
+        }
+
+        for (Gamepad* gamepad : gamepads) {
+            if (!gamepad->mapping.has_value()) {
+                continue;
+            }
+
+            handleMappedDeviceEvent(gamepad->mapping.value()->find(ev.value()),
+                                    gamepad,
+                                    timestamp);
+        }
+    }
+
+    GLFW_INPUTS_INLINE void Manager::processMouseMove(double x, double y, Timestamp timestamp)
+    {
+        if (!mouse) {
+            return;
+        }
+
+        if (rawMouseMotion) {
+            // The cursor is disabled, so positions are virtual and unbounded,
+            // and only the differences between them are meaningful
+            if (lastRawCursor.has_value()) {
+                mouse->rawMoved(x - lastRawCursor->x, y - lastRawCursor->y);
+            }
+            lastRawCursor = Position{.x = x, .y = y, .z = std::nullopt};
+            return;
+        }
+
+        if (!mouse->mapping.has_value()) {
+            return;
+        }
+
+        if (coalesceMotion) {
+            // The latest position is delivered on the next tick, where the
+            // relative movement is the sum of the movements until then
+            impl->pendingCursor.add({.x = x, .y = y, .z = std::nullopt}, timestamp, keepMotionSamples);
+            impl->pendingCursor.position = {.x = x, .y = y, .z = std::nullopt};
+            return;
+        }
+
+        mouse->positionChanged({
+            .x = x,
+            .y = y,
+            .z = std::nullopt,
+        }, MotionSurface::MouseCursor, timestamp);
+    }
+
+    GLFW_INPUTS_INLINE void Manager::processMouseWheel(double x, double y, Timestamp timestamp)
+    {
+        if (!mouse || !mouse->mapping.has_value()) {
+            return;
+        }
+
+        if (coalesceMotion) {
+            impl->pendingWheel.add({.x = x, .y = y, .z = std::nullopt}, timestamp, keepMotionSamples);
+            impl->pendingWheel.position.x += x;
+            impl->pendingWheel.position.y += y;
+            return;
+        }
+
+        mouse->relativeChanged({
+            .x = x,
+            .y = y,
+            .z = std::nullopt,
+        }, MotionSurface::MouseWheel, timestamp);
+    }
+
+    GLFW_INPUTS_INLINE void Manager::processMouseButton(int button, int action, int mods, Timestamp timestamp)
+    {
+        if (!mouse || (!mouse->mapping.has_value() && mouse->contexts.empty())) {
+            return;
+        }
+
+        InputEvent inputEvent = {
+            .event = action == 0 ? Event::ButtonRelease : Event::ButtonPress,
+            .input = static_cast<Input>(button),
+            .timestamp = timestamp,
+            .mods = mods,
+        };
+        mouse->handle(inputEvent);
+        handleInputEvent(mouse, mouse->mapping.value_or(nullptr), inputEvent);
+    }
+
+    GLFW_INPUTS_INLINE void Manager::processKeyboard(int key, int scancode, int action, int mods, Timestamp timestamp)
+    {
+        if (!keyboard || (!keyboard->mapping.has_value() && keyboard->contexts.empty()) || action > 1) {
+            return;
+        }
+
+        Event event = action == 0 ? Event::ButtonRelease : Event::ButtonPress;
+
+        // Keys unknown to GLFW are reported as GLFW_KEY_UNKNOWN (-1),
+        // which isn't representable as an Input, but can be mapped by scancode
+        if (key < 0 || key >= static_cast<int>(inputCount)) {
+            if (key == GLFW_KEY_UNKNOWN && scancode > 0) {
+                keyboard->handleScancode(event, scancode, mods);
+                handleScancodeEvent(event, scancode, mods, timestamp);
+            }
+            return;
+        }
+
+        InputEvent inputEvent = {
+            .event = event,
+            .input = static_cast<Input>(key),
+            .timestamp = timestamp,
+            .mods = mods,
+            .scancode = scancode,
+        };
+        keyboard->handle(inputEvent);
+        handleInputEvent(keyboard, keyboard->mapping.value_or(nullptr), inputEvent);
+    }
+
+    GLFW_INPUTS_INLINE void Manager::handleMappedDeviceEvent(const MappedDeviceEvent *mappedDeviceEvent, SupportsMultipleDevices* device, Timestamp timestamp)
+    {
+        if (!mappedDeviceEvent) {
+            return;
+        }
+
+        dispatch(Event::ButtonPress, {
+            .signal = mappedDeviceEvent->signal,
+            .signalId = mappedDeviceEvent->signalId,
+            .device = device,
+            .timestamp = timestamp,
+        });
+    }
+
+    GLFW_INPUTS_INLINE void Manager::handleMappedInputEvent(const MappedInputEvent *mappedInputEvent, Timestamp timestamp)
+    {
+        if (!mappedInputEvent) {
+            return;
+        }
+
+        dispatch(mappedInputEvent->inputEvent.event, {
+            .signal = mappedInputEvent->signal,
+            .signalId = mappedInputEvent->signalId,
+            .device = std::nullopt,
+            .timestamp = timestamp,
+        });
+    }
+
+    GLFW_INPUTS_INLINE void Manager::handleInputEvent(Control *control, const ControlMapping *mapping, const InputEvent &inputEvent)
+    {
+        bool consumed = control->contexts.resolve(inputEvent, [this, &inputEvent](const MappedInputEvent *mappedInputEvent) {
+            handleMappedInputEvent(mappedInputEvent, inputEvent.timestamp);
+        });
+        if (consumed || !mapping) {
+            // A press resolved by a context breaks the sequences of the mapping
+            if (consumed && inputEvent.event == Event::ButtonPress) {
+                control->comboStates.active.clear();
+            }
+            return;
+        }
+
+        handleMappedInputEvent(mapping->find(inputEvent), inputEvent.timestamp);
+        handleCombos(control, mapping, inputEvent);
+    }
+
+    GLFW_INPUTS_INLINE void Manager::handleScancodeEvent(Event event, int scancode, int mods, Timestamp timestamp)
+    {
+        // Keys without an Input aren't part of any combo, so their presses break the sequences
+        if (event == Event::ButtonPress) {
+            keyboard->comboStates.active.clear();
+        }
+
+        bool consumed = keyboard->contexts.resolveScancode(event, scancode, mods, [this, timestamp](const MappedInputEvent *mappedInputEvent) {
+            handleMappedInputEvent(mappedInputEvent, timestamp);
+        });
+        if (consumed || !keyboard->mapping.has_value()) {
+            return;
+        }
+
+        handleMappedInputEvent(keyboard->mapping.value()->findScancode(event, scancode, mods), timestamp);
+    }
+
+    GLFW_INPUTS_INLINE void Manager::handleCombos(Control *control, const ControlMapping *mapping, const InputEvent &inputEvent)
+    {
+        const ComboAutomaton &combos = mapping->getCombos();
+        if (inputEvent.event != Event::ButtonPress || combos.empty()) {
+            return;
+        }
+
+        // The states of another mapping, or of the mapping before
+        // combos were added, aren't positions in this trie
+        ComboStates &states = control->comboStates;
+        if (!combos.owns(states)) {
+            states.active.clear();
+            states.owner = &combos;
+            states.generation = combos.getGeneration();
+        }
+
+        std::optional<SupportsMultipleDevices*> device;
+        if (auto *multipleDevices = dynamic_cast<SupportsMultipleDevices *>(control)) {
+            device = multipleDevices;
+        }
+
+        combos.advance(
+            states,
+            inputEvent.input,
+            inputEvent.timestamp,
+            [control](Input input) {
+                return control->isDown(input);
+            },
+            [this, &inputEvent, device](const ComboAutomaton::Match &match) {
+                dispatch(Event::ButtonPress, {
+                    .signal = match.signal,
+                    .signalId = match.signalId,
+                    .device = device,
+                    .timestamp = inputEvent.timestamp,
+                });
+            });
+    }
+
+    GLFW_INPUTS_INLINE void Manager::dispatch(Event event, const ReceivedSignal &receivedSignal)
+    {
+        if (actionSnapshot) {
+            impl->actionSnapshots.record(receivedSignal.signalId, event);
+        }
+
+        // Signals may be consumed from the action snapshot instead
+        if (impl->listeners.dispatch(receivedSignal) || actionSnapshot) {
+            return;
+        }
+
+        warn("Leaked signal (not handled): " + std::string(receivedSignal.signal));
+    }
+
+    GLFW_INPUTS_INLINE void Manager::recordAxes(MotionControl *control)
+    {
+        if (!control || !control->mapping.has_value()) {
+            return;
+        }
+
+        for (const MappedAxis &mappedAxis : control->mapping.value()->getAxes()) {
+            if (mappedAxis.surface == MotionSurface::MouseWheel || mappedAxis.surface == MotionSurface::MouseRaw) {
+                impl->actionSnapshots.setValue(mappedAxis.signalId, control->takeRelative(mappedAxis.surface));
+            } else if (std::optional<Position> position = control->getPosition(mappedAxis.surface)) {
+                impl->actionSnapshots.setValue(mappedAxis.signalId, position.value());
+            }
+        }
+    }
+
+    GLFW_INPUTS_INLINE void Manager::processTick(Control *control, Timestamp timestamp)
+    {
+        if (!control) {
+            return;
+        }
+        for (std::size_t input : control->getHeldButtons()) {
+            handleInputEvent(control, control->mapping.value_or(nullptr), {
+                .event = Event::ButtonDown,
+                .input = static_cast<Input>(input),
+                .timestamp = timestamp,
+                .mods = control->getMods(),
+                .scancode = control->getScancode(static_cast<Input>(input)),
+            });
+        }
+    }
+
+    GLFW_INPUTS_INLINE void Manager::processTick(Keyboard *keyboardControl, Timestamp timestamp)
+    {
+        if (!keyboardControl) {
+            return;
+        }
+        processTick(static_cast<Control *>(keyboardControl), timestamp);
+
+        for (int scancode : keyboardControl->getHeldScancodes()) {
+            handleScancodeEvent(Event::ButtonDown, scancode, keyboardControl->getMods(), timestamp);
+        }
+    }
+
+    GLFW_INPUTS_INLINE void Manager::processTick(MotionControl *motionControl, Timestamp timestamp)
+    {
+        if (!motionControl) {
+            return;
+        }
+        for (std::size_t input : motionControl->getHeldButtons()) {
+            handleInputEvent(motionControl, motionControl->mapping.value_or(nullptr), {
+                .event = Event::ButtonDown,
+                .input = static_cast<Input>(input),
+                .timestamp = timestamp,
+                .mods = motionControl->getMods(),
+            });
+        }
+    }
+
+    GLFW_INPUTS_INLINE void Manager::advance(Timestamp timestamp)
+    {
+        processCoalescedMotion();
+        if (mouse) {
+            mouse->rawTick(timestamp);
+        }
+
+        processTick(keyboard, timestamp);
+        processTick(mouse, timestamp);
+
+        processJoysticks(timestamp);
+        processGamepads(timestamp);
+
+        if (actionSnapshot) {
+            recordAxes(mouse);
+            for (Joystick* joystick : joysticks) {
+                recordAxes(joystick);
+            }
+            for (Gamepad* gamepad : gamepads) {
+                recordAxes(gamepad);
+            }
+            impl->actionSnapshots.publish(timestamp);
+        }
+
+        if (recorder) {
+            recorder->recordTick(timestamp);
+        }
+    }
+
+    GLFW_INPUTS_INLINE void Manager::processCoalescedMotion()
+    {
+        if (impl->pendingCursor.pending && mouse && mouse->mapping.has_value()) {
+            mouse->positionChanged(impl->pendingCursor.position,
+                                   MotionSurface::MouseCursor,
+                                   impl->pendingCursor.timestamp,
+                                   impl->pendingCursor.view());
+        }
+        if (impl->pendingWheel.pending && mouse && mouse->mapping.has_value()) {
+            mouse->relativeChanged(impl->pendingWheel.position,
+                                   MotionSurface::MouseWheel,
+                                   impl->pendingWheel.timestamp,
+                                   impl->pendingWheel.view());
+        }
+
+        impl->pendingCursor.reset();
+        impl->pendingWheel.reset();
+    }
+
+    GLFW_INPUTS_INLINE void Manager::processJoysticks(Timestamp timestamp)
+    {
+        if (impl->joystickAxes.size() != joysticks.size() * 2) {
+            impl->joystickAxes.resize(joysticks.size() * 2);
+        }
+        impl->joystickAxes.begin();
+
+        const DevicePoll *devicePoll = buffered ? &impl->devicePolls.read() : nullptr;
+
+        for (std::size_t i = 0; i < joysticks.size(); i++) {
+            Joystick *joystick = joysticks[i];
+            if (!joystick->mapping.has_value()) {
+                continue;
+            }
+
+            // Joysticks set after the latest poll are handled from the next one
+            if (devicePoll && i >= devicePoll->joysticks.size()) {
+                continue;
+            }
+
+            const DevicePoll::JoystickState *joystickState = devicePoll ? &devicePoll->joysticks[i] : nullptr;
+            if (joystickState ? !joystickState->connected : !joystick->isConnected()) {
+                // Release the buttons which were held when the joystick disconnected
+                processJoystickButtons(joystick, nullptr, 0, timestamp);
+                continue;
+            }
+
+            int bCount;
+            int countAxes;
+            const unsigned char *buttons;
+            const float *axes;
+            if (joystickState) {
+                bCount = static_cast<int>(joystickState->buttons.size());
+                buttons = joystickState->buttons.data();
+                countAxes = static_cast<int>(joystickState->axes.size());
+                axes = joystickState->axes.empty() ? nullptr : joystickState->axes.data();
+            } else {
+                buttons = joystick->readButtons(&bCount);
+                axes = joystick->readAxes(&countAxes);
+            }
+
+            if (recorder) {
+                recorder->recordJoystick(joystick->getId(), buttons, bCount, axes, countAxes, timestamp);
+            }
+
+            processJoystickButtons(joystick, buttons, buttons ? bCount : 0, timestamp);
+
+            // Gather the axes: movement (0 and 1) and rotation (2 and 3)
+            // The number of axes can vary between joysticks
+            if (axes) {
+                auto axis = [axes, countAxes](int a) {
+                    return a < countAxes ? static_cast<double>(axes[a]) : 0.0;
+                };
+                double threshold = joystick->mapping.value()->axisFilter.threshold;
+                impl->joystickAxes.set(i * 2, axis(0), axis(1), threshold);
+                impl->joystickAxes.set(i * 2 + 1, axis(2), axis(3), threshold);
+            }
+        }
+
+        double deltaTime = previousJoystickTick.has_value()
+            ? std::chrono::duration<double>(timestamp - *previousJoystickTick).count()
+            : 0.0;
+        previousJoystickTick = timestamp;
+
+        // Filter runs of joysticks which share a mapping in one pass
+        for (std::size_t first = 0; first < joysticks.size();) {
+            std::size_t last = first + 1;
+            while (last < joysticks.size() && joysticks[last]->mapping == joysticks[first]->mapping) {
+                last++;
+            }
+            if (joysticks[first]->mapping.has_value()) {
+                impl->joystickAxes.filter(first * 2,
+                                          (last - first) * 2,
+                                          joysticks[first]->mapping.value()->axisFilter,
+                                          deltaTime);
+            }
+            first = last;
+        }
+
+        for (std::uint32_t pair : impl->joystickAxes.detectChanges()) {
+            joysticks[pair / 2]->positionChanged({
+                .x = impl->joystickAxes.x(pair),
+                .y = impl->joystickAxes.y(pair),
+                .z = std::nullopt,
+            }, pair % 2 == 0 ? MotionSurface::JoystickAxesXY : MotionSurface::JoystickRotationXY, timestamp);
+        }
+
+        // Thresholds are evaluated on every tick, for the ButtonDown events
+        // Inactive (disconnected) joysticks are evaluated as centered, which releases them
+        for (std::size_t i = 0; i < joysticks.size(); i++) {
+            Joystick *joystick = joysticks[i];
+            if (!joystick->mapping.has_value() || joystick->mapping.value()->getAxisThresholds().empty()) {
+                continue;
+            }
+
+            for (std::size_t pair = i * 2; pair < i * 2 + 2; pair++) {
+                bool active = impl->joystickAxes.isActive(pair);
+                processAxisThresholds(joystick,
+                                      joystick,
+                                      pair % 2 == 0 ? MotionSurface::JoystickAxesXY : MotionSurface::JoystickRotationXY,
+                                      {
+                                          .x = active ? impl->joystickAxes.x(pair) : 0.0,
+                                          .y = active ? impl->joystickAxes.y(pair) : 0.0,
+                                          .z = std::nullopt,
+                                      },
+                                      timestamp);
+            }
+        }
+    }
+
+    GLFW_INPUTS_INLINE void Manager::processAxisThresholds(MotionControl *control,
+                                                           SupportsMultipleDevices *device,
+                                                           MotionSurface surface,
+                                                           Position position,
+                                                           Timestamp timestamp)
+    {
+        const std::vector<MappedAxisThreshold> &thresholds = control->mapping.value()->getAxisThresholds();
+
+        for (std::size_t i = 0; i < thresholds.size(); i++) {
+            const MappedAxisThreshold &mapped = thresholds[i];
+            const AxisThreshold &axisThreshold = mapped.axisThreshold;
+            if (axisThreshold.surface != surface) {
+                continue;
+            }
+
+            // Negative thresholds are mirrored, so both directions compare the same way
+            double value = axisThreshold.axis == Axis::X ? position.x : position.y;
+            double limit = axisThreshold.threshold;
+            if (limit < 0.0) {
+                value = -value;
+                limit = -limit;
+            }
+
+            bool wasPassed = control->isAxisThresholdPassed(i);
+            bool passed = wasPassed ? value > limit - axisThreshold.hysteresis : value >= limit;
+            control->setAxisThresholdPassed(i, passed);
+
+            bool emit = (mapped.event == Event::ButtonPress && passed && !wasPassed)
+                || (mapped.event == Event::ButtonDown && passed)
+                || (mapped.event == Event::ButtonRelease && !passed && wasPassed);
+            if (emit) {
+                dispatch(mapped.event, {
+                    .signal = mapped.signal,
+                    .signalId = mapped.signalId,
+                    .device = device,
+                    .timestamp = timestamp,
+                });
+            }
+        }
+    }
+
+    GLFW_INPUTS_INLINE void Manager::processGamepads(Timestamp timestamp)
+    {
+        const DevicePoll *devicePoll = buffered ? &impl->devicePolls.read() : nullptr;
+
+        for (std::size_t index = 0; index < gamepads.size(); index++) {
+            Gamepad *gamepad = gamepads[index];
+            if (!gamepad->mapping.has_value()) {
+                continue;
+            }
+
+            // Gamepads set after the latest poll are handled from the next one
+            if (devicePoll && index >= devicePoll->gamepads.size()) {
+                continue;
+            }
+
+            bool hasThresholds = !gamepad->mapping.value()->getAxisThresholds().empty();
+
+            bool connected = devicePoll
+                ? gamepad->update(devicePoll->gamepads[index].connected, devicePoll->gamepads[index].state)
+                : gamepad->update();
+
+            ButtonSet<inputCount> current;
+            if (!connected) {
+                // Release the buttons and thresholds which were held when the gamepad disconnected
+                processButtonStates(gamepad, current, timestamp);
+                if (hasThresholds) {
+                    for (MotionSurface surface : {MotionSurface::GamepadLeftStick,
+                                                  MotionSurface::GamepadRightStick,
+                                                  MotionSurface::GamepadTriggers}) {
+                        processAxisThresholds(gamepad, gamepad, surface, {.x = 0.0, .y = 0.0, .z = std::nullopt}, timestamp);
+                    }
+                }
+                continue;
+            }
+
+            const GLFWgamepadstate &state = gamepad->getState();
+            if (recorder) {
+                recorder->recordGamepad(gamepad->getId(), state, timestamp);
+            }
+
+            for (int i = 0; i <= GLFW_GAMEPAD_BUTTON_LAST; i++) {
+                if (state.buttons[i] == GLFW_PRESS) {
+                    current.set(translateGamepadButton(i));
+                }
+            }
+            processButtonStates(gamepad, current, timestamp);
+
+            struct GamepadSurface {
+                MotionSurface surface;
+                int x, y;
+            };
+            static constexpr GamepadSurface gamepadSurfaces[] = {
+                {MotionSurface::GamepadLeftStick, GLFW_GAMEPAD_AXIS_LEFT_X, GLFW_GAMEPAD_AXIS_LEFT_Y},
+                {MotionSurface::GamepadRightStick, GLFW_GAMEPAD_AXIS_RIGHT_X, GLFW_GAMEPAD_AXIS_RIGHT_Y},
+                {MotionSurface::GamepadTriggers, GLFW_GAMEPAD_AXIS_LEFT_TRIGGER, GLFW_GAMEPAD_AXIS_RIGHT_TRIGGER},
+            };
+
+            for (const GamepadSurface &gamepadSurface : gamepadSurfaces) {
+                Position position = {
+                    .x = state.axes[gamepadSurface.x],
+                    .y = state.axes[gamepadSurface.y],
+                    .z = std::nullopt,
+                };
+
+                // GLFW reports triggers from -1 (released) to 1 (pulled)
+                if (gamepadSurface.surface == MotionSurface::GamepadTriggers) {
+                    position = {
+                        .x = (position.x + 1.0) / 2.0,
+                        .y = (position.y + 1.0) / 2.0,
+                        .z = std::nullopt,
+                    };
+                }
+
+                Position filtered = gamepad->axesChanged(position, gamepadSurface.surface, timestamp);
+
+                if (hasThresholds) {
+                    processAxisThresholds(gamepad, gamepad, gamepadSurface.surface, filtered, timestamp);
+                }
+            }
+        }
+    }
+
+    GLFW_INPUTS_INLINE void Manager::processJoystickButtons(Joystick *joystick,
+                                                            const unsigned char *buttons,
+                                                            int count,
+                                                            Timestamp timestamp)
+    {
+        ButtonSet<inputCount> current;
+
+        // Buttons beyond those represented in Input are ignored
+        count = std::min(count, static_cast<int>(joystickButtonCount));
+        for (int i = 0; i < count; i++) {
+            if (buttons[i] == GLFW_PRESS) {
+                current.set(translateJoystickButton(i));
+            }
+        }
+
+        processButtonStates(joystick, current, timestamp);
+    }
+
+    GLFW_INPUTS_INLINE void Manager::processButtonStates(MotionControl *control,
+                                                         const ButtonSet<inputCount> &current,
+                                                         Timestamp timestamp)
+    {
+        ButtonSet<inputCount> pressed, released;
+
+        const ButtonSet<inputCount> &previous = control->getHeldButtons();
+        for (std::size_t w = 0; w < ButtonSet<inputCount>::wordCount; w++) {
+            ButtonSet<inputCount>::Word changed = current.word(w) ^ previous.word(w);
+            pressed.word(w) = changed & current.word(w);
+            released.word(w) = changed & previous.word(w);
+        }
+
+        for (std::size_t input : released) {
+            handleButton(control, Event::ButtonRelease, static_cast<Input>(input), timestamp);
+        }
+        for (std::size_t input : pressed) {
+            handleButton(control, Event::ButtonPress, static_cast<Input>(input), timestamp);
+        }
+        for (std::size_t input : current) {
+            handleButton(control, Event::ButtonDown, static_cast<Input>(input), timestamp);
+        }
+    }
+
+    GLFW_INPUTS_INLINE void Manager::handleButton(MotionControl *control, Event event, Input input, Timestamp timestamp)
+    {
+        InputEvent inputEvent = {
+            .event = event,
+            .input = input,
+            .timestamp = timestamp,
+        };
+        control->handle(inputEvent);
+        handleInputEvent(control, control->mapping.value(), inputEvent);
+    }
+
+    GLFW_INPUTS_INLINE Input Manager::translateJoystickButton(int btn)
+    {
+        static constexpr std::array<Input, joystickButtonCount> joystickInputs = {
+                Input::JoystickButton1,
+                Input::JoystickButton2,
+                Input::JoystickButton3,
+                Input::JoystickButton4,
+                Input::JoystickButton5,
+                Input::JoystickButton6,
+                Input::JoystickButton7,
+                Input::JoystickButton8,
+                Input::JoystickButton9,
+                Input::JoystickButton10,
+                Input::JoystickButton11,
+                Input::JoystickButton12
+        };
+        return joystickInputs[btn];
+    }
+
+    GLFW_INPUTS_INLINE Input Manager::translateGamepadButton(int btn)
+    {
+        static constexpr std::array<Input, GLFW_GAMEPAD_BUTTON_LAST + 1> gamepadInputs = {
+                Input::GamepadA,
+                Input::GamepadB,
+                Input::GamepadX,
+                Input::GamepadY,
+                Input::GamepadLeftBumper,
+                Input::GamepadRightBumper,
+                Input::GamepadBack,
+                Input::GamepadStart,
+                Input::GamepadGuide,
+                Input::GamepadLeftThumb,
+                Input::GamepadRightThumb,
+                Input::GamepadDpadUp,
+                Input::GamepadDpadRight,
+                Input::GamepadDpadDown,
+                Input::GamepadDpadLeft
+        };
+        return gamepadInputs[btn];
+    }
+
+}
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef GLFW_INPUTS_TESTS_MAPPING_CONTEXT_STACK_HPP
+#define GLFW_INPUTS_TESTS_MAPPING_CONTEXT_STACK_HPP
+
+#include "../glfw-inputs.hpp"
+
+/**
+ * Definitions of MappingContextStack::resolve and resolveScancode,
+ * which are templates, instantiated by the Manager
+ */
+
+namespace GLFW_Inputs {
+
+    template<typename OnMapped>
+    bool MappingContextStack::resolve(const InputEvent &inputEvent, OnMapped onMapped) const
+    {
+        auto input = static_cast<std::size_t>(inputEvent.input);
+        if (count == 0 || inputEvent.input < 0 || input >= inputCount) {
+            return false;
+        }
+
+        std::uint32_t candidates = table[static_cast<std::size_t>(inputEvent.event) * inputCount + input];
+        if (inputEvent.scancode > 0) {
+            candidates |= scancodeContexts;
+        }
+
+        for (std::size_t i = 0; candidates != 0; i++, candidates >>= 1) {
+            if ((candidates & 1) == 0) {
+                continue;
+            }
+            const MappedInputEvent *mappedInputEvent = contexts[i].mapping->find(inputEvent);
+            if (!mappedInputEvent) {
+                continue;
+            }
+            onMapped(mappedInputEvent);
+            if (contexts[i].mode == ContextMode::Consume) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template<typename OnMapped>
+    bool MappingContextStack::resolveScancode(Event event, int scancode, int mods, OnMapped onMapped) const
+    {
+        std::uint32_t candidates = scancode > 0 ? scancodeContexts : 0;
+
+        for (std::size_t i = 0; candidates != 0; i++, candidates >>= 1) {
+            if ((candidates & 1) == 0) {
+                continue;
+            }
+            const MappedInputEvent *mappedInputEvent = contexts[i].mapping->findScancode(event, scancode, mods);
+            if (!mappedInputEvent) {
+                continue;
+            }
+            onMapped(mappedInputEvent);
+            if (contexts[i].mode == ContextMode::Consume) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+}
+
+#endif
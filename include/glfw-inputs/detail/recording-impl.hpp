@@ -0,0 +1,517 @@
+#ifndef GLFW_INPUTS_TESTS_RECORDING_IMPL_HPP
+#define GLFW_INPUTS_TESTS_RECORDING_IMPL_HPP
+
+#include "../glfw-inputs.hpp"
+#include "../binary-stream.hpp"
+#include <cmath>
+
+/**
+ * Definitions of InputRecorder and InputPlayer
+ *
+ * Included by glfw-inputs.hpp, unless GLFW_INPUTS_COMPILED_LIB is defined,
+ * in which case the definitions are compiled once in the library
+ */
+
+namespace GLFW_Inputs {
+
+    struct InputRecorder::Impl {
+        struct JoystickState {
+            bool valid = false;
+            std::vector<unsigned char> buttons;
+            std::vector<float> axes;
+        };
+
+        struct GamepadState {
+            bool valid = false;
+            GLFWgamepadstate state{};
+        };
+
+        BinaryWriter writer;
+
+        Timestamp previous;
+
+        std::array<JoystickState, GLFW_JOYSTICK_LAST + 1> joysticks;
+
+        std::array<GamepadState, GLFW_JOYSTICK_LAST + 1> gamepads;
+
+        Impl(std::ostream &stream, std::size_t bufferSize) : writer(stream, bufferSize), previous(Clock::now())
+        {
+            writer.writeBytes(magic, sizeof(magic));
+            writer.writeByte(version);
+        }
+
+        void recordInput(const RawInput &rawInput, const char *deviceName);
+
+        void recordJoystick(int jid,
+                            const unsigned char *buttons,
+                            int buttonCount,
+                            const float *axes,
+                            int axisCount,
+                            Timestamp timestamp);
+
+        void recordGamepad(int jid, const GLFWgamepadstate &state, Timestamp timestamp);
+
+        void writeHeader(RecordType type, Timestamp timestamp)
+        {
+            writer.writeByte(static_cast<std::uint8_t>(type));
+            writer.writeSignedVarint(std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp - previous).count());
+            previous = timestamp;
+        }
+
+        /**
+         * Cursor positions are usually whole numbers, in which case they're
+         * written as variable-length integers, and otherwise as doubles
+         */
+        void writeCoordinates(double x, double y);
+
+        static bool isWhole(double value)
+        {
+            return std::abs(value) < 1e15 && std::floor(value) == value;
+        }
+    };
+
+    struct InputPlayer::Impl {
+        BinaryReader reader;
+
+        Manager &manager;
+
+        SyntheticBackend &backend;
+
+        /**
+         * The (replayed) time of the latest record
+         */
+        Timestamp time;
+
+        std::size_t ticks = 0;
+
+        bool finished = false;
+
+        // Reused between records, to avoid allocating
+        std::vector<unsigned char> buttons;
+        std::vector<float> axes;
+        std::string name;
+
+        Impl(std::istream &stream, Manager &manager, SyntheticBackend &backend, std::size_t bufferSize);
+
+        bool step();
+
+        bool corrupt()
+        {
+            finished = true;
+            error("Corrupt input recording");
+            return false;
+        }
+
+        bool replayInput();
+
+        bool replayJoystick();
+
+        bool replayGamepad();
+
+        bool readCoordinates(double &x, double &y);
+    };
+
+    GLFW_INPUTS_INLINE InputRecorder::InputRecorder(std::ostream &stream, std::size_t bufferSize)
+        : impl(std::make_unique<Impl>(stream, bufferSize)) { }
+
+    GLFW_INPUTS_INLINE InputRecorder::~InputRecorder() = default;
+
+    GLFW_INPUTS_INLINE void InputRecorder::recordInput(const RawInput &rawInput, const char *deviceName)
+    {
+        impl->recordInput(rawInput, deviceName);
+    }
+
+    GLFW_INPUTS_INLINE void InputRecorder::recordJoystick(int jid,
+                                                          const unsigned char *buttons,
+                                                          int buttonCount,
+                                                          const float *axes,
+                                                          int axisCount,
+                                                          Timestamp timestamp)
+    {
+        impl->recordJoystick(jid, buttons, buttonCount, axes, axisCount, timestamp);
+    }
+
+    GLFW_INPUTS_INLINE void InputRecorder::recordGamepad(int jid, const GLFWgamepadstate &state, Timestamp timestamp)
+    {
+        impl->recordGamepad(jid, state, timestamp);
+    }
+
+    GLFW_INPUTS_INLINE void InputRecorder::recordTick(Timestamp timestamp)
+    {
+        impl->writeHeader(RecordType::Tick, timestamp);
+    }
+
+    GLFW_INPUTS_INLINE void InputRecorder::flush()
+    {
+        impl->writer.flush();
+    }
+
+    GLFW_INPUTS_INLINE InputPlayer::InputPlayer(std::istream &stream,
+                                                Manager &manager,
+                                                SyntheticBackend &backend,
+                                                std::size_t bufferSize)
+        : impl(std::make_unique<Impl>(stream, manager, backend, bufferSize)) { }
+
+    GLFW_INPUTS_INLINE InputPlayer::~InputPlayer() = default;
+
+    GLFW_INPUTS_INLINE bool InputPlayer::step()
+    {
+        return impl->step();
+    }
+
+    GLFW_INPUTS_INLINE std::size_t InputPlayer::play()
+    {
+        std::size_t before = impl->ticks;
+        while (impl->step()) { }
+        return impl->ticks - before;
+    }
+
+    GLFW_INPUTS_INLINE std::size_t InputPlayer::getTicks() const
+    {
+        return impl->ticks;
+    }
+
+    GLFW_INPUTS_INLINE bool InputPlayer::isFinished() const
+    {
+        return impl->finished;
+    }
+
+    GLFW_INPUTS_INLINE void InputRecorder::Impl::recordInput(const RawInput &rawInput, const char *deviceName)
+    {
+        writeHeader(RecordType::Input, rawInput.timestamp);
+        writer.writeByte(static_cast<std::uint8_t>(rawInput.type));
+
+        switch (rawInput.type) {
+            case RawInputType::Keyboard:
+                writer.writeSignedVarint(rawInput.code);
+                writer.writeSignedVarint(rawInput.scancode);
+                writer.writeByte(static_cast<std::uint8_t>(rawInput.action));
+                writer.writeByte(static_cast<std::uint8_t>(rawInput.mods));
+                break;
+            case RawInputType::MouseButton:
+                writer.writeSignedVarint(rawInput.code);
+                writer.writeByte(static_cast<std::uint8_t>(rawInput.action));
+                writer.writeByte(static_cast<std::uint8_t>(rawInput.mods));
+                break;
+            case RawInputType::MouseMove:
+            case RawInputType::MouseWheel:
+                writeCoordinates(rawInput.x, rawInput.y);
+                break;
+            case RawInputType::JoystickConnection: {
+                bool connected = rawInput.action == GLFW_CONNECTED;
+                std::string_view name = connected && deviceName ? deviceName : "";
+                writer.writeVarint(static_cast<std::uint64_t>(rawInput.code));
+                writer.writeByte(connected ? 1 : 0);
+                writer.writeVarint(name.size());
+                writer.writeBytes(name.data(), name.size());
+
+                // The device may have changed, so its next state is always recorded
+                if (rawInput.code >= 0 && rawInput.code <= GLFW_JOYSTICK_LAST) {
+                    joysticks[rawInput.code].valid = false;
+                    gamepads[rawInput.code].valid = false;
+                }
+                break;
+            }
+        }
+    }
+
+    GLFW_INPUTS_INLINE void InputRecorder::Impl::recordJoystick(int jid,
+                                                                const unsigned char *buttons,
+                                                                int buttonCount,
+                                                                const float *axes,
+                                                                int axisCount,
+                                                                Timestamp timestamp)
+    {
+        if (jid < 0 || jid > GLFW_JOYSTICK_LAST) {
+            return;
+        }
+
+        buttonCount = buttons ? buttonCount : 0;
+        axisCount = axes ? axisCount : 0;
+
+        JoystickState &last = joysticks[jid];
+        if (last.valid
+            && std::equal(buttons, buttons + buttonCount, last.buttons.begin(), last.buttons.end())
+            && std::equal(axes, axes + axisCount, last.axes.begin(), last.axes.end())) {
+            return;
+        }
+        last.valid = true;
+        last.buttons.assign(buttons, buttons + buttonCount);
+        last.axes.assign(axes, axes + axisCount);
+
+        writeHeader(RecordType::JoystickState, timestamp);
+        writer.writeVarint(static_cast<std::uint64_t>(jid));
+
+        // Buttons are packed as bits
+        writer.writeVarint(static_cast<std::uint64_t>(buttonCount));
+        for (int i = 0; i < buttonCount; i += 8) {
+            std::uint8_t packed = 0;
+            for (int b = i; b < std::min(i + 8, buttonCount); b++) {
+                packed |= (buttons[b] == GLFW_PRESS ? 1 : 0) << (b - i);
+            }
+            writer.writeByte(packed);
+        }
+
+        writer.writeVarint(static_cast<std::uint64_t>(axisCount));
+        for (int a = 0; a < axisCount; a++) {
+            writer.writeFloat(axes[a]);
+        }
+    }
+
+    GLFW_INPUTS_INLINE void InputRecorder::Impl::recordGamepad(int jid, const GLFWgamepadstate &state, Timestamp timestamp)
+    {
+        if (jid < 0 || jid > GLFW_JOYSTICK_LAST) {
+            return;
+        }
+
+        GamepadState &last = gamepads[jid];
+        if (last.valid
+            && std::equal(std::begin(state.buttons), std::end(state.buttons), std::begin(last.state.buttons))
+            && std::equal(std::begin(state.axes), std::end(state.axes), std::begin(last.state.axes))) {
+            return;
+        }
+        last.valid = true;
+        last.state = state;
+
+        writeHeader(RecordType::GamepadState, timestamp);
+        writer.writeVarint(static_cast<std::uint64_t>(jid));
+
+        std::uint16_t packed = 0;
+        for (int i = 0; i <= GLFW_GAMEPAD_BUTTON_LAST; i++) {
+            packed |= (state.buttons[i] == GLFW_PRESS ? 1 : 0) << i;
+        }
+        writer.writeByte(static_cast<std::uint8_t>(packed));
+        writer.writeByte(static_cast<std::uint8_t>(packed >> 8));
+
+        for (float axis : state.axes) {
+            writer.writeFloat(axis);
+        }
+    }
+
+    GLFW_INPUTS_INLINE void InputRecorder::Impl::writeCoordinates(double x, double y)
+    {
+        bool whole = isWhole(x) && isWhole(y);
+        writer.writeByte(whole ? 1 : 0);
+        if (whole) {
+            writer.writeSignedVarint(static_cast<std::int64_t>(x));
+            writer.writeSignedVarint(static_cast<std::int64_t>(y));
+        } else {
+            writer.writeDouble(x);
+            writer.writeDouble(y);
+        }
+    }
+
+    GLFW_INPUTS_INLINE InputPlayer::Impl::Impl(std::istream &stream,
+                                               Manager &manager,
+                                               SyntheticBackend &backend,
+                                               std::size_t bufferSize)
+        : reader(stream, bufferSize), manager(manager), backend(backend), time(Clock::now())
+    {
+        char magic[sizeof(InputRecorder::magic)];
+        std::uint8_t version;
+        if (!reader.readBytes(magic, sizeof(magic))
+            || !std::equal(std::begin(magic), std::end(magic), std::begin(InputRecorder::magic))
+            || !reader.readByte(version)
+            || version != InputRecorder::version) {
+            finished = true;
+            error("Invalid or unsupported input recording");
+        }
+    }
+
+    GLFW_INPUTS_INLINE bool InputPlayer::Impl::step()
+    {
+        while (!finished) {
+            std::uint8_t type;
+            std::int64_t delta;
+            if (!reader.readByte(type)) {
+                finished = true;
+                break;
+            }
+            if (!reader.readSignedVarint(delta)) {
+                return corrupt();
+            }
+            time += std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(delta));
+
+            switch (static_cast<RecordType>(type)) {
+                case RecordType::Input:
+                    if (!replayInput()) {
+                        return corrupt();
+                    }
+                    break;
+                case RecordType::JoystickState:
+                    if (!replayJoystick()) {
+                        return corrupt();
+                    }
+                    break;
+                case RecordType::GamepadState:
+                    if (!replayGamepad()) {
+                        return corrupt();
+                    }
+                    break;
+                case RecordType::Tick:
+                    manager.poll();
+                    manager.drain();
+                    manager.advance(time);
+                    ticks++;
+                    return true;
+                default:
+                    return corrupt();
+            }
+        }
+
+        // Inputs recorded after the last tick
+        manager.drain();
+        return false;
+    }
+
+    GLFW_INPUTS_INLINE bool InputPlayer::Impl::replayInput()
+    {
+        std::uint8_t type;
+        if (!reader.readByte(type)) {
+            return false;
+        }
+
+        RawInput rawInput = {
+            .type = static_cast<RawInputType>(type),
+            .timestamp = time,
+        };
+
+        std::int64_t code = 0, scancode = 0;
+        std::uint8_t action = 0, mods = 0;
+        switch (rawInput.type) {
+            case RawInputType::Keyboard:
+                if (!reader.readSignedVarint(code)
+                    || !reader.readSignedVarint(scancode)
+                    || !reader.readByte(action)
+                    || !reader.readByte(mods)) {
+                    return false;
+                }
+                break;
+            case RawInputType::MouseButton:
+                if (!reader.readSignedVarint(code)
+                    || !reader.readByte(action)
+                    || !reader.readByte(mods)) {
+                    return false;
+                }
+                break;
+            case RawInputType::MouseMove:
+            case RawInputType::MouseWheel:
+                if (!readCoordinates(rawInput.x, rawInput.y)) {
+                    return false;
+                }
+                break;
+            case RawInputType::JoystickConnection: {
+                std::uint64_t jid, length;
+                std::uint8_t connected;
+                if (!reader.readVarint(jid)
+                    || !reader.readByte(connected)
+                    || !reader.readVarint(length)
+                    || length > 1024) {
+                    return false;
+                }
+                name.resize(length);
+                if (!reader.readBytes(name.data(), length)) {
+                    return false;
+                }
+
+                code = static_cast<std::int64_t>(jid);
+                rawInput.action = connected ? GLFW_CONNECTED : GLFW_DISCONNECTED;
+                backend.setJoystickPresent(static_cast<int>(jid), connected, name);
+                break;
+            }
+            default:
+                return false;
+        }
+
+        rawInput.code = static_cast<int>(code);
+        rawInput.scancode = static_cast<int>(scancode);
+        if (rawInput.type != RawInputType::JoystickConnection) {
+            rawInput.action = action;
+        }
+        rawInput.mods = mods;
+
+        manager.submit(rawInput);
+        return true;
+    }
+
+    GLFW_INPUTS_INLINE bool InputPlayer::Impl::replayJoystick()
+    {
+        std::uint64_t jid, buttonCount, axisCount;
+        if (!reader.readVarint(jid) || !reader.readVarint(buttonCount) || buttonCount > 1024) {
+            return false;
+        }
+
+        buttons.resize(buttonCount);
+        for (std::size_t i = 0; i < buttonCount; i += 8) {
+            std::uint8_t packed;
+            if (!reader.readByte(packed)) {
+                return false;
+            }
+            for (std::size_t b = i; b < std::min<std::size_t>(i + 8, buttonCount); b++) {
+                buttons[b] = (packed >> (b - i)) & 1 ? GLFW_PRESS : GLFW_RELEASE;
+            }
+        }
+
+        if (!reader.readVarint(axisCount) || axisCount > 1024) {
+            return false;
+        }
+        axes.resize(axisCount);
+        for (float &axis : axes) {
+            if (!reader.readFloat(axis)) {
+                return false;
+            }
+        }
+
+        backend.setJoystickState(static_cast<int>(jid),
+                                 buttons.data(),
+                                 static_cast<int>(buttons.size()),
+                                 axes.data(),
+                                 static_cast<int>(axes.size()));
+        return true;
+    }
+
+    GLFW_INPUTS_INLINE bool InputPlayer::Impl::replayGamepad()
+    {
+        std::uint64_t jid;
+        std::uint8_t low, high;
+        if (!reader.readVarint(jid) || !reader.readByte(low) || !reader.readByte(high)) {
+            return false;
+        }
+
+        GLFWgamepadstate state{};
+        std::uint16_t packed = static_cast<std::uint16_t>(low | (high << 8));
+        for (int i = 0; i <= GLFW_GAMEPAD_BUTTON_LAST; i++) {
+            state.buttons[i] = (packed >> i) & 1 ? GLFW_PRESS : GLFW_RELEASE;
+        }
+        for (float &axis : state.axes) {
+            if (!reader.readFloat(axis)) {
+                return false;
+            }
+        }
+
+        backend.setGamepadState(static_cast<int>(jid), state);
+        return true;
+    }
+
+    GLFW_INPUTS_INLINE bool InputPlayer::Impl::readCoordinates(double &x, double &y)
+    {
+        std::uint8_t whole;
+        if (!reader.readByte(whole)) {
+            return false;
+        }
+        if (!whole) {
+            return reader.readDouble(x) && reader.readDouble(y);
+        }
+
+        std::int64_t wholeX, wholeY;
+        if (!reader.readSignedVarint(wholeX) || !reader.readSignedVarint(wholeY)) {
+            return false;
+        }
+        x = static_cast<double>(wholeX);
+        y = static_cast<double>(wholeY);
+        return true;
+    }
+
+}
+
+#endif
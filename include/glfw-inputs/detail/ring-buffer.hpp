@@ -0,0 +1,132 @@
+#ifndef GLFW_INPUTS_TESTS_RING_BUFFER_HPP
+#define GLFW_INPUTS_TESTS_RING_BUFFER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace GLFW_Inputs {
+
+    /**
+     * Ring Buffer
+     *
+     * A bounded, lock-free, single-producer/single-consumer queue.
+     * One thread may push while another thread pops, without locking.
+     *
+     * The storage is allocated once by reserve, and is never
+     * reallocated while the buffer is in use.
+     */
+    template<typename T>
+    class RingBuffer {
+    public:
+
+        /**
+         * Create a ring buffer
+         *
+         * @param std::size_t capacity Rounded up to a power of two
+         */
+        explicit RingBuffer(std::size_t capacity = 0)
+        {
+            reserve(capacity);
+        }
+
+        RingBuffer(const RingBuffer &) = delete;
+
+        RingBuffer &operator=(const RingBuffer &) = delete;
+
+        /**
+         * (Re-)allocate the storage, discarding any queued items
+         *
+         * Must not be called while other threads push or pop
+         *
+         * @param std::size_t capacity Rounded up to a power of two
+         * @return void
+         */
+        void reserve(std::size_t capacity)
+        {
+            std::size_t size = 1;
+            while (size < capacity) {
+                size <<= 1;
+            }
+
+            slots = capacity > 0 ? std::make_unique<T[]>(size) : nullptr;
+            mask = capacity > 0 ? size - 1 : 0;
+            head.store(0, std::memory_order_relaxed);
+            tail.store(0, std::memory_order_relaxed);
+        }
+
+        /**
+         * Push an item (producer thread)
+         *
+         * @param const T& item
+         * @return bool False if the buffer is full, in which case the item is dropped
+         */
+        bool push(const T &item)
+        {
+            if (!slots) {
+                return false;
+            }
+
+            std::size_t position = tail.load(std::memory_order_relaxed);
+            if (position - head.load(std::memory_order_acquire) > mask) {
+                return false;
+            }
+
+            slots[position & mask] = item;
+            tail.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * Returns true if the next push would fail (producer thread)
+         *
+         * @return bool
+         */
+        [[nodiscard]] bool full() const
+        {
+            return !slots || tail.load(std::memory_order_relaxed) - head.load(std::memory_order_acquire) > mask;
+        }
+
+        /**
+         * Pop an item (consumer thread)
+         *
+         * @param T& item Receives the popped item
+         * @return bool False if the buffer is empty
+         */
+        bool pop(T &item)
+        {
+            std::size_t position = head.load(std::memory_order_relaxed);
+            if (position == tail.load(std::memory_order_acquire)) {
+                return false;
+            }
+
+            item = slots[position & mask];
+            head.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * The number of items the buffer can hold
+         *
+         * @return std::size_t
+         */
+        [[nodiscard]] std::size_t capacity() const
+        {
+            return slots ? mask + 1 : 0;
+        }
+
+    private:
+        std::unique_ptr<T[]> slots;
+
+        std::size_t mask = 0;
+
+        // Kept on separate cache lines to avoid false sharing
+        // between the producer and consumer threads
+        alignas(64) std::atomic<std::size_t> head{0};
+        alignas(64) std::atomic<std::size_t> tail{0};
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,249 @@
+#ifndef GLFW_INPUTS_TESTS_SIGNAL_LISTENERS_HPP
+#define GLFW_INPUTS_TESTS_SIGNAL_LISTENERS_HPP
+
+#include "../glfw-inputs.hpp"
+
+namespace GLFW_Inputs {
+
+    /**
+     * Signal Listeners
+     *
+     * Registry of the handlers listening for each signal. A signal can
+     * have any number of handlers, which are invoked in the order they were added.
+     *
+     * Handlers are small-buffer delegates stored in a single contiguous vector,
+     * grouped by signal, so dispatching a signal walks one contiguous range
+     * and never allocates.
+     *
+     * Handlers may subscribe and unsubscribe while a signal is being
+     * dispatched. Such changes are applied once dispatching has finished,
+     * also when a handler throws.
+     */
+    class SignalListeners {
+    public:
+        using Handler = SignalHandler;
+
+        /**
+         * Add a handler for a signal
+         *
+         * @param SignalId signalId
+         * @param Handler handler
+         * @return Subscription
+         */
+        Subscription subscribe(SignalId signalId, Handler handler)
+        {
+            Subscription subscription = {
+                .signalId = signalId,
+                .id = nextId++,
+            };
+
+            if (dispatching > 0) {
+                pending.push_back({
+                    .signalId = signalId,
+                    .listener = {
+                        .id = subscription.id,
+                        .handler = std::move(handler),
+                    },
+                });
+            } else {
+                insert(signalId, {
+                    .id = subscription.id,
+                    .handler = std::move(handler),
+                });
+            }
+
+            return subscription;
+        }
+
+        /**
+         * Remove a handler
+         *
+         * @param Subscription subscription
+         * @return bool False if the subscription wasn't found
+         */
+        bool unsubscribe(Subscription subscription)
+        {
+            if (!subscription.isValid()) {
+                return false;
+            }
+
+            for (auto it = pending.begin(); it != pending.end(); it++) {
+                if (it->listener.id == subscription.id) {
+                    pending.erase(it);
+                    return true;
+                }
+            }
+
+            if (subscription.signalId >= ranges.size()) {
+                return false;
+            }
+
+            Range &range = ranges[subscription.signalId];
+            for (std::uint32_t i = range.begin; i < range.begin + range.count; i++) {
+                if (listeners[i].id != subscription.id) {
+                    continue;
+                }
+
+                if (dispatching > 0) {
+                    // Leave a tombstone, which is swept when dispatching ends.
+                    // The handler may still be running, so it's destroyed by the sweep.
+                    listeners[i].id = 0;
+                    needsSweep = true;
+                } else {
+                    erase(subscription.signalId, i);
+                }
+                return true;
+            }
+
+            return false;
+        }
+
+        /**
+         * Returns true if the signal has at least one handler
+         *
+         * @param SignalId signalId
+         * @return bool
+         */
+        [[nodiscard]] bool has(SignalId signalId) const
+        {
+            return signalId < ranges.size() && ranges[signalId].count > 0;
+        }
+
+        /**
+         * Invoke all handlers of the received signal
+         *
+         * @param const ReceivedSignal& receivedSignal
+         * @return bool False if the signal has no handlers
+         */
+        bool dispatch(const ReceivedSignal &receivedSignal)
+        {
+            if (!has(receivedSignal.signalId)) {
+                return false;
+            }
+
+            DispatchScope scope(*this);
+            const Range &range = ranges[receivedSignal.signalId];
+            for (std::uint32_t i = range.begin; i < range.begin + range.count; i++) {
+                if (listeners[i].id != 0) {
+                    listeners[i].handler(receivedSignal);
+                }
+            }
+            return true;
+        }
+
+    private:
+        struct Listener {
+            std::uint32_t id;
+            Handler handler;
+        };
+
+        struct PendingListener {
+            SignalId signalId;
+            Listener listener;
+        };
+
+        /**
+         * Marks a dispatch in progress, and applies the deferred changes
+         * when the outermost dispatch ends, also when a handler throws
+         */
+        struct DispatchScope {
+            SignalListeners &owner;
+
+            explicit DispatchScope(SignalListeners &listeners) : owner(listeners)
+            {
+                owner.dispatching++;
+            }
+
+            DispatchScope(const DispatchScope &) = delete;
+
+            DispatchScope &operator=(const DispatchScope &) = delete;
+
+            ~DispatchScope()
+            {
+                owner.dispatching--;
+                if (owner.dispatching == 0) {
+                    owner.applyDeferred();
+                }
+            }
+        };
+
+        /**
+         * Position and length of a signal's handlers in the listeners vector
+         */
+        struct Range {
+            std::uint32_t begin = 0;
+            std::uint32_t count = 0;
+        };
+
+        std::vector<Listener> listeners;
+
+        /**
+         * Ranges, indexed by SignalId
+         */
+        std::vector<Range> ranges;
+
+        std::vector<PendingListener> pending;
+
+        std::uint32_t nextId = 1;
+
+        int dispatching = 0;
+
+        bool needsSweep = false;
+
+        void insert(SignalId signalId, Listener listener)
+        {
+            if (signalId >= ranges.size()) {
+                ranges.resize(signalId + 1, {
+                    .begin = static_cast<std::uint32_t>(listeners.size()),
+                    .count = 0,
+                });
+            }
+
+            std::uint32_t position = ranges[signalId].begin + ranges[signalId].count;
+            listeners.insert(listeners.begin() + position, std::move(listener));
+
+            for (SignalId other = 0; other < ranges.size(); other++) {
+                if (other != signalId && ranges[other].begin >= position) {
+                    ranges[other].begin++;
+                }
+            }
+            ranges[signalId].count++;
+        }
+
+        void erase(SignalId signalId, std::uint32_t position)
+        {
+            listeners.erase(listeners.begin() + position);
+
+            for (SignalId other = 0; other < ranges.size(); other++) {
+                if (other != signalId && ranges[other].begin > position) {
+                    ranges[other].begin--;
+                }
+            }
+            ranges[signalId].count--;
+        }
+
+        void applyDeferred()
+        {
+            if (needsSweep) {
+                needsSweep = false;
+                for (SignalId signalId = 0; signalId < ranges.size(); signalId++) {
+                    for (std::uint32_t i = ranges[signalId].begin + ranges[signalId].count; i > ranges[signalId].begin; i--) {
+                        if (listeners[i - 1].id == 0) {
+                            erase(signalId, i - 1);
+                        }
+                    }
+                }
+            }
+
+            while (!pending.empty()) {
+                PendingListener item = std::move(pending.front());
+                pending.erase(pending.begin());
+                insert(item.signalId, std::move(item.listener));
+            }
+        }
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef GLFW_INPUTS_TESTS_SIGNALS_IMPL_HPP
+#define GLFW_INPUTS_TESTS_SIGNALS_IMPL_HPP
+
+#include "../glfw-inputs.hpp"
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+/**
+ * Definitions of SignalRegistry and Messaging
+ *
+ * Included by glfw-inputs.hpp, unless GLFW_INPUTS_COMPILED_LIB is defined,
+ * in which case the definitions are compiled once in the library
+ */
+
+namespace GLFW_Inputs {
+
+    /**
+     * A deque is used for the names, because it never moves existing
+     * elements, which keeps the views held by the ID table valid
+     */
+    struct SignalRegistry::State {
+        std::mutex mutex;
+        std::deque<std::string> names;
+        std::unordered_map<std::string_view, SignalId> ids;
+    };
+
+    GLFW_INPUTS_INLINE SignalId SignalRegistry::intern(std::string_view name)
+    {
+        State &registry = state();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        auto existing = registry.ids.find(name);
+        if (existing != registry.ids.end()) {
+            return existing->second;
+        }
+
+        auto id = static_cast<SignalId>(registry.names.size());
+        registry.names.emplace_back(name);
+        registry.ids.emplace(registry.names.back(), id);
+        return id;
+    }
+
+    GLFW_INPUTS_INLINE std::optional<SignalId> SignalRegistry::find(std::string_view name)
+    {
+        State &registry = state();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        auto existing = registry.ids.find(name);
+        if (existing == registry.ids.end()) {
+            return std::nullopt;
+        }
+        return existing->second;
+    }
+
+    GLFW_INPUTS_INLINE std::string_view SignalRegistry::name(SignalId id)
+    {
+        State &registry = state();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        if (id >= registry.names.size()) {
+            return {};
+        }
+        return registry.names[id];
+    }
+
+    GLFW_INPUTS_INLINE std::size_t SignalRegistry::size()
+    {
+        State &registry = state();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        return registry.names.size();
+    }
+
+    GLFW_INPUTS_INLINE SignalRegistry::State &SignalRegistry::state()
+    {
+        static State registry;
+        return registry;
+    }
+
+    GLFW_INPUTS_INLINE void Messaging::displayMessage(const std::string& message, MessagingMethod method)
+    {
+        switch (method) {
+            case MessagingMethod::Silent:
+                break;
+            case MessagingMethod::StdCout:
+                std::cout << message << std::endl;
+                break;
+            case MessagingMethod::StdCerr:
+                std::cerr << message << std::endl;
+                break;
+            case MessagingMethod::Exception:
+                throw std::runtime_error(message);
+        }
+    }
+
+}
+
+#endif
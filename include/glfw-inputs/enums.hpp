@@ -2,6 +2,7 @@
 #define GLFW_INPUTS_TESTS_ENUMS_HPP
 
 #include "include.hpp"
+#include <cstddef>
 
 namespace GLFW_Inputs {
 
@@ -27,9 +28,75 @@ namespace GLFW_Inputs {
     enum class MotionSurface {
         MouseCursor,
         MouseWheel,
+        MouseRaw,
 
         JoystickAxesXY,
         JoystickRotationXY,
+
+        GamepadLeftStick,
+        GamepadRightStick,
+        GamepadTriggers,
+    };
+
+    /**
+     * Number of motion surfaces
+     * Must be kept in sync with the last enumeration of MotionSurface
+     */
+    constexpr std::size_t motionSurfaceCount = static_cast<std::size_t>(MotionSurface::GamepadTriggers) + 1;
+
+    /**
+     * Axis
+     *
+     * One of the two axes of a motion surface
+     */
+    enum class Axis {
+        X,
+        Y,
+    };
+
+    /**
+     * Deadzone
+     *
+     * How the deadzone of an AxisFilter is applied to a pair of axes
+     *
+     * @see https://glfw-inputs.readthedocs.io/en/latest/misc/axis-filter/
+     */
+    enum class Deadzone {
+        None,
+        Axial,
+        Radial,
+    };
+
+    /**
+     * Smoothing
+     *
+     * How an AxisFilter smooths the values of a pair of axes over time
+     *
+     * @see https://glfw-inputs.readthedocs.io/en/latest/misc/axis-filter/
+     */
+    enum class Smoothing {
+        None,
+        Exponential,
+        OneEuro,
+    };
+
+    /**
+     * Context Mode
+     *
+     * What a mapping context does with the inputs it maps
+     *
+     * @see https://glfw-inputs.readthedocs.io/en/latest/controls/mapping-contexts/
+     */
+    enum class ContextMode {
+        /**
+         * Mapped inputs aren't passed to the contexts below
+         */
+        Consume,
+
+        /**
+         * Mapped inputs are also passed to the contexts below
+         */
+        PassThrough,
     };
 
     /**
@@ -42,6 +109,61 @@ namespace GLFW_Inputs {
         Disconnected,
     };
 
+    /**
+     * Raw Input Type
+     *
+     * Identifies which GLFW callback a RawInput originates from
+     */
+    enum class RawInputType : unsigned char {
+        Keyboard,
+        MouseButton,
+        MouseMove,
+        MouseWheel,
+        JoystickConnection,
+    };
+
+    /**
+     * Record Type
+     *
+     * Identifies the records of an input recording
+     *
+     * @see https://glfw-inputs.readthedocs.io/en/latest/misc/recording/
+     */
+    enum class RecordType : unsigned char {
+        Input = 1,
+        JoystickState = 2,
+        GamepadState = 3,
+        Tick = 4,
+    };
+
+    /**
+     * Profile Format
+     *
+     * The formats mapping profiles can be saved in
+     *
+     * @see https://glfw-inputs.readthedocs.io/en/latest/controls/mapping-profiles/
+     */
+    enum class ProfileFormat {
+        Text,
+        Binary,
+    };
+
+    /**
+     * Profile Record Type
+     *
+     * Identifies the records of a binary mapping profile
+     *
+     * @see https://glfw-inputs.readthedocs.io/en/latest/controls/mapping-profiles/
+     */
+    enum class ProfileRecordType : unsigned char {
+        Input = 1,
+        Scancode = 2,
+        Device = 3,
+        AxisThreshold = 4,
+        Axis = 5,
+        AxisFilter = 6,
+    };
+
     /**
      * Event
      *
@@ -60,6 +182,46 @@ namespace GLFW_Inputs {
         ButtonRelease,
     };
 
+    /**
+     * Number of enumerators in Event
+     * Used to size lookup tables indexed by event
+     */
+    constexpr std::size_t eventCount = 3;
+
+    /**
+     * Modifier
+     *
+     * Modifier keys held during an input event, as reported by GLFW.
+     * Combine them with |, for example ModCtrl | ModShift.
+     *
+     * @see https://glfw-inputs.readthedocs.io/en/latest/controls/keyboard/
+     */
+    enum Modifier {
+        ModNone = 0,
+        ModShift = GLFW_MOD_SHIFT,
+        ModCtrl = GLFW_MOD_CONTROL,
+        ModAlt = GLFW_MOD_ALT,
+        ModSuper = GLFW_MOD_SUPER,
+    };
+
+    /**
+     * The modifiers which are part of a mapping
+     * Lock modifiers (Caps Lock and Num Lock) are ignored
+     */
+    constexpr int modifierMask = ModShift | ModCtrl | ModAlt | ModSuper;
+
+    /**
+     * Number of distinct combinations of modifierMask
+     * Used to size lookup tables indexed by modifiers
+     */
+    constexpr std::size_t modifierCombinations = modifierMask + 1;
+
+    /**
+     * Used in place of modifiers, for mappings which match
+     * regardless of the held modifiers
+     */
+    constexpr int anyModifiers = -1;
+
     /**
      * Input
      *
@@ -221,7 +383,30 @@ namespace GLFW_Inputs {
         JoystickButton11 = GLFW_JOYSTICK_11,
         JoystickButton12 = GLFW_JOYSTICK_12,
 
+        // Gamepad (standardized layout, named after the Xbox controller)
+        GamepadA = GLFW_GAMEPAD_BUTTON_A,
+        GamepadB = GLFW_GAMEPAD_BUTTON_B,
+        GamepadX = GLFW_GAMEPAD_BUTTON_X,
+        GamepadY = GLFW_GAMEPAD_BUTTON_Y,
+        GamepadLeftBumper = GLFW_GAMEPAD_BUTTON_LEFT_BUMPER,
+        GamepadRightBumper = GLFW_GAMEPAD_BUTTON_RIGHT_BUMPER,
+        GamepadBack = GLFW_GAMEPAD_BUTTON_BACK,
+        GamepadStart = GLFW_GAMEPAD_BUTTON_START,
+        GamepadGuide = GLFW_GAMEPAD_BUTTON_GUIDE,
+        GamepadLeftThumb = GLFW_GAMEPAD_BUTTON_LEFT_THUMB,
+        GamepadRightThumb = GLFW_GAMEPAD_BUTTON_RIGHT_THUMB,
+        GamepadDpadUp = GLFW_GAMEPAD_BUTTON_DPAD_UP,
+        GamepadDpadRight = GLFW_GAMEPAD_BUTTON_DPAD_RIGHT,
+        GamepadDpadDown = GLFW_GAMEPAD_BUTTON_DPAD_DOWN,
+        GamepadDpadLeft = GLFW_GAMEPAD_BUTTON_DPAD_LEFT,
+
     };
+
+    /**
+     * Upper bound (exclusive) of the values in Input
+     * Used to size lookup tables indexed by input
+     */
+    constexpr std::size_t inputCount = GLFW_KEY_LAST + 1;
 };
 
 #endif
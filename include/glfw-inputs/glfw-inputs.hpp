@@ -3,11 +3,22 @@
 
 #include "include.hpp"
 #include "enums.hpp"
+#include "delegate.hpp"
+#include "button-set.hpp"
+#include "axis-filter.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
 #include <optional>
-#include <map>
+#include <memory>
 #include <functional>
+#include <string_view>
 #include <utility>
-#include <regex>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 /**
  * GLFW Inputs
@@ -22,10 +33,144 @@
 namespace GLFW_Inputs {
 
     /**
-     * Signal name regular expression
-     * Used to verify applied signal names
+     * Is valid signal name
+     *
+     * Signal names consist of lowercase words separated by
+     * single underscores, such as "jump" or "open_menu"
+     *
+     * @param std::string_view name
+     * @return bool
+     */
+    constexpr bool isValidSignalName(std::string_view name)
+    {
+        if (name.empty() || name.front() == '_' || name.back() == '_') {
+            return false;
+        }
+
+        char previous = '\0';
+        for (char character : name) {
+            bool valid = (character >= 'a' && character <= 'z') || (character == '_' && previous != '_');
+            if (!valid) {
+                return false;
+            }
+            previous = character;
+        }
+        return true;
+    }
+
+    /**
+     * Signal Name
+     *
+     * A signal name which is validated when it's constructed. Declared
+     * constexpr, invalid names are reported at compile time:
+     *
+     *     constexpr SignalName jump = "jump";
+     *
+     * Converts to std::string, so it can be passed wherever a signal is expected.
+     */
+    class SignalName {
+    public:
+        template<std::size_t N>
+        constexpr SignalName(const char (&name)[N])
+            : name(validate(std::string_view(name, N - 1))) { }
+
+        [[nodiscard]] constexpr std::string_view view() const
+        {
+            return name;
+        }
+
+        operator std::string() const
+        {
+            return std::string(name);
+        }
+
+    private:
+        std::string_view name;
+
+        static constexpr std::string_view validate(std::string_view name)
+        {
+            // Throwing isn't allowed in constant expressions, which turns this into a compile error
+            return isValidSignalName(name) ? name : throw std::invalid_argument("Signal name not compliant");
+        }
+    };
+
+    /**
+     * Signal ID
+     *
+     * Compact integer representation of a signal name, as
+     * assigned by the SignalRegistry
+     */
+    using SignalId = std::uint32_t;
+
+    /**
+     * Signal Registry
+     *
+     * Interns signal names into compact SignalIds, so signals can be
+     * dispatched by integer indexing rather than by comparing strings.
+     * Interning happens when mappings and listeners are registered,
+     * never while inputs are being dispatched.
+     *
+     * The registry is shared by the whole process, and is safe to
+     * use from multiple threads.
+     */
+    class SignalRegistry {
+    public:
+
+        /**
+         * Get the ID of a signal name, assigning a new ID
+         * if the name hasn't been seen before
+         *
+         * @param std::string_view name
+         * @return SignalId
+         */
+        static SignalId intern(std::string_view name);
+
+        /**
+         * Get the ID of a signal name without assigning a new one
+         *
+         * @param std::string_view name
+         * @return std::optional<SignalId>
+         */
+        [[nodiscard]] static std::optional<SignalId> find(std::string_view name);
+
+        /**
+         * Reverse lookup of a signal name, mostly useful for debugging
+         *
+         * The returned view stays valid for the lifetime of the process.
+         *
+         * @param SignalId id
+         * @return std::string_view Empty if the ID hasn't been assigned
+         */
+        [[nodiscard]] static std::string_view name(SignalId id);
+
+        /**
+         * Number of signals interned so far
+         *
+         * @return std::size_t
+         */
+        [[nodiscard]] static std::size_t size();
+
+    private:
+        struct State;
+
+        static State &state();
+
+    };
+
+    /**
+     * Clock used to timestamp inputs
+     *
+     * Monotonic and high-resolution, which makes it suitable for
+     * measuring latency and ordering inputs across devices
+     */
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Timestamp
+     *
+     * The point in time at which an input was captured
      */
-    const std::regex regexSignalName(R"(^[a-z]+(_[a-z]+){0,}$)");
+    using Timestamp = Clock::time_point;
 
     /**
      * Input Event
@@ -38,6 +183,51 @@ namespace GLFW_Inputs {
     struct InputEvent {
         Event event;
         Input input;
+        Timestamp timestamp;
+
+        /**
+         * Modifier keys held during the event (see Modifier)
+         */
+        int mods = 0;
+
+        /**
+         * Platform-specific scancode of keyboard keys, or 0
+         */
+        int scancode = 0;
+    };
+
+    /**
+     * Raw Input
+     *
+     * Compact record of a single GLFW callback invocation, as it was received.
+     * Used by the Manager to queue inputs in buffered mode.
+     */
+    struct RawInput {
+        RawInputType type;
+
+        /**
+         * Key, mouse button or joystick ID
+         */
+        int code = 0;
+
+        int scancode = 0;
+
+        /**
+         * GLFW action, or the GLFW event for joystick connections
+         */
+        int action = 0;
+
+        int mods = 0;
+
+        /**
+         * Cursor position or scroll offset
+         */
+        double x = 0, y = 0;
+
+        /**
+         * Time at which the GLFW callback was invoked
+         */
+        Timestamp timestamp;
     };
 
     /**
@@ -51,6 +241,7 @@ namespace GLFW_Inputs {
     struct MappedInputEvent {
         InputEvent inputEvent;
         std::string signal;
+        SignalId signalId;
     };
 
     /**
@@ -64,6 +255,49 @@ namespace GLFW_Inputs {
     struct MappedDeviceEvent {
         DeviceEvent deviceEvent;
         std::string signal;
+        SignalId signalId;
+    };
+
+    /**
+     * Axis Threshold
+     *
+     * Turns an analog axis into a button, which is pressed when the
+     * axis passes the threshold, and released when it returns past the
+     * threshold minus the hysteresis. Negative thresholds are passed
+     * by values below them.
+     *
+     * @see https://glfw-inputs.readthedocs.io/en/latest/misc/axis-threshold/
+     */
+    struct AxisThreshold {
+        MotionSurface surface;
+        Axis axis;
+        double threshold;
+        double hysteresis = 0.05;
+    };
+
+    /**
+     * Mapped Axis Threshold
+     *
+     * Associates an event of an axis threshold with a signal.
+     * Used in MotionControlMapping classes.
+     */
+    struct MappedAxisThreshold {
+        AxisThreshold axisThreshold;
+        Event event;
+        std::string signal;
+        SignalId signalId;
+    };
+
+    /**
+     * Mapped Axis
+     *
+     * Associates the value of a motion surface with a signal, which
+     * is available in the ActionSnapshot. Used in MotionControlMapping classes.
+     */
+    struct MappedAxis {
+        MotionSurface surface;
+        std::string signal;
+        SignalId signalId;
     };
 
     /**
@@ -79,6 +313,52 @@ namespace GLFW_Inputs {
         std::optional<double> z;
     };
 
+    /**
+     * Motion Sample
+     *
+     * A single movement received from GLFW
+     */
+    struct MotionSample {
+        Position position;
+        Timestamp timestamp;
+    };
+
+    /**
+     * Motion Samples
+     *
+     * Read-only view of the motion samples which were coalesced into a
+     * MotionEvent. Only valid during the onMove callback.
+     */
+    struct MotionSamples {
+        const MotionSample *data = nullptr;
+        std::size_t count = 0;
+
+        [[nodiscard]] const MotionSample *begin() const
+        {
+            return data;
+        }
+
+        [[nodiscard]] const MotionSample *end() const
+        {
+            return data + count;
+        }
+
+        [[nodiscard]] std::size_t size() const
+        {
+            return count;
+        }
+
+        [[nodiscard]] bool empty() const
+        {
+            return count == 0;
+        }
+
+        const MotionSample &operator[](std::size_t index) const
+        {
+            return data[index];
+        }
+    };
+
     /**
      * Motion Event
      *
@@ -91,6 +371,8 @@ namespace GLFW_Inputs {
     struct MotionEvent {
         std::optional<Position> position, relative;
         MotionSurface surface;
+        Timestamp timestamp;
+        MotionSamples samples;
     };
 
     /**
@@ -102,8 +384,8 @@ namespace GLFW_Inputs {
      */
     class Messaging {
     public:
-        static MessagingMethod warnings;
-        static MessagingMethod errors;
+        inline static MessagingMethod warnings = MessagingMethod::StdCout;
+        inline static MessagingMethod errors = MessagingMethod::Exception;
 
     protected:
 
@@ -140,22 +422,34 @@ namespace GLFW_Inputs {
          * @param MessagingMethod method
          * @return void
          */
-        static void displayMessage(const std::string& message, MessagingMethod method)
-        {
-            switch (method) {
-                case MessagingMethod::Silent:
-                    break;
-                case MessagingMethod::StdCout:
-                    std::cout << message << std::endl;
-                    break;
-                case MessagingMethod::StdCerr:
-                    std::cerr << message << std::endl;
-                    break;
-                case MessagingMethod::Exception:
-                    throw std::runtime_error(message);
-            }
-        }
+        static void displayMessage(const std::string& message, MessagingMethod method);
+
+    };
+
+    class ComboAutomaton;
+
+    /**
+     * Combo State
+     *
+     * A position in the trie of the chords and sequences of a mapping,
+     * reached by a sequence which started at the given time
+     */
+    struct ComboState {
+        std::uint32_t node;
+        Timestamp start;
+    };
+
+    /**
+     * Combo States
+     *
+     * The chords and sequences a control is in the middle of, in the
+     * trie of the automaton (and generation of it) which created them
+     */
+    struct ComboStates {
+        std::vector<ComboState> active, next;
 
+        const ComboAutomaton *owner = nullptr;
+        std::uint32_t generation = 0;
     };
 
     /**
@@ -169,35 +463,58 @@ namespace GLFW_Inputs {
     class ControlMapping : public Messaging {
     public:
 
+        /**
+         * Create an empty mapping
+         */
+        ControlMapping();
+
+        ControlMapping(const ControlMapping &other);
+
+        ControlMapping(ControlMapping &&other) noexcept;
+
+        ControlMapping &operator=(const ControlMapping &other);
+
+        ControlMapping &operator=(ControlMapping &&other) noexcept;
+
+        ~ControlMapping();
+
         /**
          * On (register an event)
          *
          * Specify on the mapping how a specific input event should
          * map to a given signal
          *
+         * When the same input event is registered more than once,
+         * the first registration is kept, and the others are ignored
+         * with a warning
+         *
+         * With modifiers, the mapping only matches when exactly these
+         * modifiers are held (such as ModCtrl | ModShift), and takes
+         * precedence over the mapping of the input without modifiers
+         *
          * @see https://glfw-inputs.readthedocs.io/en/latest/getting-started/basic-usage/
          *      Guide on how to use the mapping feature
          *
          * @param Event event
          * @param Input input
          * @param std::string signal
+         * @param int mods Modifiers, or anyModifiers to ignore them
          * @return void
          */
-        void on(Event event, Input input, std::string signal)
+        void on(Event event, Input input, std::string signal, int mods = anyModifiers)
         {
-            std::smatch matches;
-            std::string target = signal;
-            if (!std::regex_search(target, matches, regexSignalName)) {
-                error("Signal name not compliant: " + signal);
+            std::optional<std::size_t> slot = slotOf({
+                .event = event,
+                .input = input,
+                .timestamp = {},
+            });
+            if (!slot.has_value()) {
+                error("Input out of range: " + std::to_string(input));
+                return;
             }
 
-            mappedInputEvents.push_back({
-                .inputEvent = {
-                    .event = event,
-                    .input = input,
-                },
-                .signal = signal,
-            });
+            int &entry = mods == anyModifiers ? lookup[slot.value()] : modifierTable(mods)[slot.value()];
+            map(entry, {.event = event, .input = input, .timestamp = {}, .mods = mods}, std::move(signal));
         }
 
         /**
@@ -211,12 +528,134 @@ namespace GLFW_Inputs {
          */
         void on(DeviceEvent deviceEvent, std::string signal)
         {
+            SignalId signalId = SignalRegistry::intern(signal);
             mappedDeviceEvents.push_back({
                 .deviceEvent = deviceEvent,
                 .signal = std::move(signal),
+                .signalId = signalId,
+            });
+        }
+
+        /**
+         * Find (InputEvent)
+         *
+         * Look up the MappedInputEvent which matches the provided InputEvent.
+         * The lookup is a single table access, and nothing is copied, which
+         * makes it suitable for the per-event and per-tick paths.
+         *
+         * The returned pointer is valid until the mapping is modified.
+         *
+         * @param InputEvent inputEvent
+         * @return const MappedInputEvent* nullptr when nothing is mapped
+         */
+        [[nodiscard]] const MappedInputEvent *find(InputEvent inputEvent) const
+        {
+            std::size_t mods = inputEvent.mods & modifierMask;
+
+            // Scancode mappings are the most specific, then exact modifiers
+            if (const MappedInputEvent *mappedInputEvent = findScancode(inputEvent.event, inputEvent.scancode, inputEvent.mods)) {
+                return mappedInputEvent;
+            }
+
+            std::optional<std::size_t> slot = slotOf(inputEvent);
+            if (!slot.has_value()) {
+                return nullptr;
+            }
+
+            const std::vector<int> &table = modifierLookup[mods];
+            if (!table.empty() && table[slot.value()] != unmapped) {
+                return &mappedInputEvents[table[slot.value()]];
+            }
+
+            if (lookup[slot.value()] == unmapped) {
+                return nullptr;
+            }
+            return &mappedInputEvents[lookup[slot.value()]];
+        }
+
+        /**
+         * Find (Scancode)
+         *
+         * Look up the scancode mapping of an event, ignoring key mappings.
+         * Used on its own for keys which GLFW has no key for (GLFW_KEY_UNKNOWN),
+         * which can only be mapped by their scancode.
+         *
+         * @param Event event
+         * @param int scancode
+         * @param int mods
+         * @return const MappedInputEvent* nullptr when the scancode isn't mapped
+         */
+        [[nodiscard]] const MappedInputEvent *findScancode(Event event, int scancode, int mods) const
+        {
+            if (scancode <= 0 || scancodeLookup.empty()) {
+                return nullptr;
+            }
+
+            for (std::size_t modsIndex : {static_cast<std::size_t>(mods & modifierMask), modifierCombinations}) {
+                std::size_t slot = scancodeSlotOf(event, scancode, modsIndex);
+                if (slot < scancodeLookup.size() && scancodeLookup[slot] != unmapped) {
+                    return &mappedInputEvents[scancodeLookup[slot]];
+                }
+            }
+            return nullptr;
+        }
+
+        /**
+         * Returns the mapped input events, in the order they were registered
+         *
+         * @return const std::vector<MappedInputEvent>&
+         */
+        [[nodiscard]] const std::vector<MappedInputEvent> &getInputEvents() const
+        {
+            return mappedInputEvents;
+        }
+
+        /**
+         * Returns the mapped device events, in the order they were registered
+         *
+         * @return const std::vector<MappedDeviceEvent>&
+         */
+        [[nodiscard]] const std::vector<MappedDeviceEvent> &getDeviceEvents() const
+        {
+            return mappedDeviceEvents;
+        }
+
+        /**
+         * Returns true if the input event is mapped, with any modifiers
+         * (scancode mappings aren't considered)
+         *
+         * @param Event event
+         * @param Input input
+         * @return bool
+         */
+        [[nodiscard]] bool maps(Event event, Input input) const
+        {
+            std::optional<std::size_t> slot = slotOf({
+                .event = event,
+                .input = input,
+                .timestamp = {},
+            });
+            if (!slot.has_value()) {
+                return false;
+            }
+            if (lookup[slot.value()] != unmapped) {
+                return true;
+            }
+            return std::any_of(modifierLookup.begin(), modifierLookup.end(), [&slot](const std::vector<int> &table) {
+                return !table.empty() && table[slot.value()] != unmapped;
             });
         }
 
+        /**
+         * Returns true if the mapping has scancode mappings
+         *
+         * @return bool
+         */
+        [[nodiscard]] bool hasScancodes() const
+        {
+            return !scancodeLookup.empty();
+        }
+
         /**
          * Get Event (InputEvent)
          *
@@ -228,13 +667,11 @@ namespace GLFW_Inputs {
          */
         [[nodiscard]] std::optional<MappedInputEvent> getEvent(InputEvent inputEvent) const
         {
-            for (MappedInputEvent mappedInputEvent : mappedInputEvents) {
-                if (mappedInputEvent.inputEvent.event == inputEvent.event
-                    && mappedInputEvent.inputEvent.input == inputEvent.input) {
-                    return mappedInputEvent;
-                }
+            const MappedInputEvent *mappedInputEvent = find(inputEvent);
+            if (!mappedInputEvent) {
+                return std::nullopt;
             }
-            return std::nullopt;
+            return *mappedInputEvent;
         }
 
         /**
@@ -248,451 +685,2390 @@ namespace GLFW_Inputs {
          */
         [[nodiscard]] std::optional<MappedDeviceEvent> getEvent(DeviceEvent deviceEvent) const
         {
-            for (MappedDeviceEvent mappedDeviceEvent : mappedDeviceEvents) {
+            const MappedDeviceEvent *mappedDeviceEvent = find(deviceEvent);
+            if (!mappedDeviceEvent) {
+                return std::nullopt;
+            }
+            return *mappedDeviceEvent;
+        }
+
+        /**
+         * Find (DeviceEvent)
+         *
+         * The same as getEvent, but without copying the MappedDeviceEvent
+         *
+         * @param DeviceEvent deviceEvent
+         * @return const MappedDeviceEvent* nullptr when nothing is mapped
+         */
+        [[nodiscard]] const MappedDeviceEvent *find(DeviceEvent deviceEvent) const
+        {
+            for (const MappedDeviceEvent &mappedDeviceEvent : mappedDeviceEvents) {
                 if (mappedDeviceEvent.deviceEvent == deviceEvent) {
-                    return mappedDeviceEvent;
+                    return &mappedDeviceEvent;
                 }
             }
-            return std::nullopt;
+            return nullptr;
         }
 
-    protected:
-        std::vector<MappedInputEvent> mappedInputEvents;
+        /**
+         * On (Chord)
+         *
+         * Emits the signal when all the inputs are held at the same
+         * time, regardless of the order they were pressed in
+         *
+         * @param const std::vector<Input>& inputs
+         * @param std::string signal
+         * @return void
+         */
+        void onChord(const std::vector<Input> &inputs, std::string signal)
+        {
+            onSequence({inputs}, signal, Clock::duration::max());
+        }
 
-        std::vector<MappedDeviceEvent> mappedDeviceEvents;
+        /**
+         * On (Sequence)
+         *
+         * Emits the signal when the steps are pressed in order, within the
+         * time window (from the first to the last step). Each step is
+         * one or more inputs, which must be held together.
+         *
+         * @param const std::vector<std::vector<Input>>& steps
+         * @param std::string signal
+         * @param Clock::duration window
+         * @return void
+         */
+        void onSequence(const std::vector<std::vector<Input>> &steps,
+                        std::string signal,
+                        Clock::duration window = std::chrono::milliseconds(500));
 
-    };
+        /**
+         * Returns the compiled chords and sequences
+         *
+         * @return const ComboAutomaton&
+         */
+        [[nodiscard]] const ComboAutomaton &getCombos() const;
 
-    /**
-     * Motion Control Mapping
-     *
-     * ControlMapping adapted for MotionControl classes
-     *
-     * @see https://glfw-inputs.readthedocs.io/en/latest/controls/control-mapping/
-     */
-    class MotionControlMapping : public ControlMapping {
-    public:
+    protected:
+        std::vector<MappedInputEvent> mappedInputEvents;
+
+        std::vector<MappedDeviceEvent> mappedDeviceEvents;
 
         /**
-         * OnMove handler
-         * Optionally used by control mappings to determine what should happen
-         * when various control surfaces are moved
+         * Allocated when the first chord or sequence is added
          */
-        std::optional<std::function<void(MotionEvent motionEvent)>> onMove;
+        std::unique_ptr<ComboAutomaton> combos;
 
-    };
+        /**
+         * Map a scancode, for layout-independent bindings
+         *
+         * @param Event event
+         * @param int scancode
+         * @param std::string signal
+         * @param int mods Modifiers, or anyModifiers to ignore them
+         * @return void
+         */
+        void mapScancode(Event event, int scancode, std::string signal, int mods)
+        {
+            if (scancode <= 0) {
+                error("Scancode out of range: " + std::to_string(scancode));
+                return;
+            }
+            if (mods != anyModifiers && (mods & ~modifierMask) != 0) {
+                error("Unsupported modifiers: " + std::to_string(mods));
+                return;
+            }
 
-    /**
-     * Keyboard mapping
-     *
-     * @see https://glfw-inputs.readthedocs.io/en/latest/controls/keyboard/
-     */
-    class KeyboardMapping : public ControlMapping {
+            std::size_t modsIndex = mods == anyModifiers ? modifierCombinations : static_cast<std::size_t>(mods);
+            std::size_t slot = scancodeSlotOf(event, scancode, modsIndex);
+            if (slot >= scancodeLookup.size()) {
+                scancodeLookup.resize(scancodeSlotOf(event, scancode + 1, 0), unmapped);
+            }
 
-    };
+            map(scancodeLookup[slot], {
+                .event = event,
+                .input = {},
+                .timestamp = {},
+                .mods = mods,
+                .scancode = scancode,
+            }, std::move(signal));
+        }
 
-    /**
-     * Mouse mapping
-     *
-     * @see https://glfw-inputs.readthedocs.io/en/latest/controls/mouse/
-     */
-    class MouseMapping : public MotionControlMapping {
+    private:
 
-    };
+        /**
+         * Marks a slot in the lookup table which has no mapping
+         */
+        static constexpr int unmapped = -1;
 
-    /**
-     * Joystick mapping
-     *
-     * @see https://glfw-inputs.readthedocs.io/en/latest/controls/joystick/
-     */
-    class JoystickMapping : public MotionControlMapping {
+        /**
+         * Dense lookup table indexed by (Event, Input), holding the
+         * index of the matching entry in mappedInputEvents
+         */
+        std::array<int, eventCount * inputCount> lookup{};
 
-    };
+        /**
+         * Lookup tables of the mappings with modifiers, one per combination
+         * of modifiers, allocated when the first mapping with that
+         * combination is registered
+         */
+        std::array<std::vector<int>, modifierCombinations> modifierLookup;
 
-    /**
-     * Control
-     *
-     * The base of the controls (keyboard, mouse, joystick)
-     */
-    class Control {
-    public:
+        /**
+         * Lookup table of scancode mappings, indexed by
+         * (scancode, modifiers, Event), grown to fit the largest scancode
+         * The modifiers include an extra slot for anyModifiers
+         */
+        std::vector<int> scancodeLookup;
 
         /**
-         * Handle input event
-         *
-         * Keeps track of the down-states of buttons
+         * Register a mapped input event in a slot of a lookup table,
+         * unless the slot is already taken
          *
+         * @param int& slot
          * @param InputEvent inputEvent
+         * @param std::string signal
          * @return void
          */
-        virtual void handle(InputEvent inputEvent)
+        void map(int &slot, InputEvent inputEvent, std::string signal)
         {
-            if (inputEvent.event == Event::ButtonPress) {
-                buttonsDown[inputEvent.input] = true;
-            } else if (inputEvent.event == Event::ButtonRelease) {
-                buttonsDown[inputEvent.input] = false;
+            if (!isValidSignalName(signal)) {
+                error("Signal name not compliant: " + signal);
+            }
+
+            if (slot != unmapped) {
+                warn("Input event already mapped, ignored: " + signal);
+                return;
             }
+            slot = static_cast<int>(mappedInputEvents.size());
+
+            SignalId signalId = SignalRegistry::intern(signal);
+            mappedInputEvents.push_back({
+                .inputEvent = inputEvent,
+                .signal = std::move(signal),
+                .signalId = signalId,
+            });
         }
 
         /**
-         * Get buttons currently pressed down
+         * Get the lookup table of a combination of modifiers, allocating it if needed
          *
-         * @see https://glfw-inputs.readthedocs.io/en/latest/getting-started/button-down-states/
-         * @return std::vector<int>
+         * @param int mods
+         * @return std::vector<int>&
          */
-        [[nodiscard]] std::vector<int> getButtonsDown() const
+        std::vector<int> &modifierTable(int mods)
         {
-            std::vector<int> list;
-            for (auto item : buttonsDown) {
-                if (item.second) {
-                    list.push_back(item.first);
-                }
+            if ((mods & ~modifierMask) != 0 || mods < 0) {
+                error("Unsupported modifiers: " + std::to_string(mods));
+                mods &= modifierMask;
             }
-            return list;
+
+            std::vector<int> &table = modifierLookup[static_cast<std::size_t>(mods)];
+            if (table.empty()) {
+                table.assign(eventCount * inputCount, unmapped);
+            }
+            return table;
         }
 
-        std::optional<ControlMapping *> mapping = std::nullopt;
+        [[nodiscard]] static std::size_t scancodeSlotOf(Event event, int scancode, std::size_t modsIndex)
+        {
+            return (static_cast<std::size_t>(scancode) * (modifierCombinations + 1) + modsIndex) * eventCount
+                   + static_cast<std::size_t>(event);
+        }
 
-    protected:
-        std::map<int, bool> buttonsDown;
+        /**
+         * Compute the position of an input event in the lookup table
+         *
+         * @param InputEvent inputEvent
+         * @return std::optional<std::size_t> std::nullopt when the input is out of range
+         */
+        [[nodiscard]] static std::optional<std::size_t> slotOf(InputEvent inputEvent)
+        {
+            auto input = static_cast<std::size_t>(inputEvent.input);
+            if (inputEvent.input < 0 || input >= inputCount) {
+                return std::nullopt;
+            }
+            return static_cast<std::size_t>(inputEvent.event) * inputCount + input;
+        }
 
     };
 
     /**
-     * Motion Control
+     * Motion Control Mapping
      *
-     * An extension of the Control class which includes motion surfaces
-     * such as the mouse cursor, mouse wheel and joystick axes
+     * ControlMapping adapted for MotionControl classes
      *
-     * @see https://glfw-inputs.readthedocs.io/en/latest/getting-started/motion-controls/
+     * @see https://glfw-inputs.readthedocs.io/en/latest/controls/control-mapping/
      */
-    class MotionControl : public Control {
+    class MotionControlMapping : public ControlMapping {
     public:
+        using ControlMapping::on;
 
         /**
-         * Position changed
+         * On (Axis Threshold)
          *
-         * Used when a control has a fixed position, such as the mouse cursor
+         * Map an analog axis passing a threshold to a signal, with the same
+         * semantics as buttons: Event::ButtonPress when the threshold is passed,
+         * Event::ButtonDown on every tick while it's passed, and
+         * Event::ButtonRelease when the axis returns
          *
-         * @param Position position
-         * @param MotionSurface surface
+         * @param Event event
+         * @param AxisThreshold axisThreshold
+         * @param std::string signal
          * @return void
          */
-        void positionChanged(Position position, MotionSurface surface)
+        void on(Event event, AxisThreshold axisThreshold, std::string signal)
         {
-            std::optional<Position> lastOnSurface = last[surface];
-
-            if (lastOnSurface.has_value()) {
-                relative[surface]->x = position.x - lastOnSurface.value().x;
-                relative[surface]->y = position.y - lastOnSurface.value().y;
-                if (lastOnSurface.value().z.has_value() && position.z.has_value()) {
-                    relative[surface]->z = position.z.value() - lastOnSurface.value().z.value();
-                }
+            if (!isValidSignalName(signal)) {
+                error("Signal name not compliant: " + signal);
             }
 
-            last[surface] = position;
+            SignalId signalId = SignalRegistry::intern(signal);
+            mappedAxisThresholds.push_back({
+                .axisThreshold = axisThreshold,
+                .event = event,
+                .signal = std::move(signal),
+                .signalId = signalId,
+            });
+        }
 
-            if (mapping.has_value() && mapping.value()->onMove.has_value()) {
-                mapping.value()->onMove.value()({
-                    .position = lastOnSurface,
-                    .relative = relative[surface],
-                    .surface = surface,
-                });
-            }
+        /**
+         * Returns the mapped axis thresholds
+         *
+         * @return const std::vector<MappedAxisThreshold>&
+         */
+        [[nodiscard]] const std::vector<MappedAxisThreshold> &getAxisThresholds() const
+        {
+            return mappedAxisThresholds;
         }
 
         /**
-         * Relative changed
+         * On Axis
          *
-         * Used when the position of the control isn't relevant, for instance
-         * applicable for the mouse wheel
+         * Map the value of a motion surface to a signal, which is available
+         * with ActionSnapshot::getValue once per tick. Surfaces with a position
+         * (such as sticks and the cursor) have their latest position, and
+         * relative surfaces (the wheel and raw motion) the sum of the
+         * movements since the previous tick.
          *
-         * @param Position relative
          * @param MotionSurface surface
+         * @param std::string signal
          * @return void
          */
-        void relativeChanged(Position relative, MotionSurface surface)
+        void onAxis(MotionSurface surface, std::string signal)
         {
-            if (mapping.has_value() && mapping.value()->onMove.has_value()) {
-                mapping.value()->onMove.value()({
-                    .position = std::nullopt,
-                    .relative = relative,
-                    .surface = surface,
-                });
+            if (!isValidSignalName(signal)) {
+                error("Signal name not compliant: " + signal);
             }
+
+            SignalId signalId = SignalRegistry::intern(signal);
+            mappedAxes.push_back({
+                .surface = surface,
+                .signal = std::move(signal),
+                .signalId = signalId,
+            });
         }
 
-        std::optional<MotionControlMapping *> mapping = std::nullopt;
+        /**
+         * Returns the mapped axes
+         *
+         * @return const std::vector<MappedAxis>&
+         */
+        [[nodiscard]] const std::vector<MappedAxis> &getAxes() const
+        {
+            return mappedAxes;
+        }
+
+        /**
+         * OnMove handler
+         * Optionally used by control mappings to determine what should happen
+         * when various control surfaces are moved
+         */
+        std::optional<std::function<void(MotionEvent motionEvent)>> onMove;
+
+        /**
+         * Filter applied to analog axes (of joysticks and gamepads)
+         * before they're dispatched to onMove
+         *
+         * @see https://glfw-inputs.readthedocs.io/en/latest/misc/axis-filter/
+         */
+        AxisFilter axisFilter;
 
     protected:
-        std::map<MotionSurface, std::optional<Position>> last, relative;
+        std::vector<MappedAxisThreshold> mappedAxisThresholds;
+
+        std::vector<MappedAxis> mappedAxes;
 
     };
 
     /**
-     * Supports Multiple Devices
-     *
-     * Trait for control types with support for multiple
-     * devices at the same time such as joysticks and gamepads
+     * Keyboard mapping
      *
-     * @see https://glfw-inputs.readthedocs.io/en/latest/misc/control-traits/
+     * @see https://glfw-inputs.readthedocs.io/en/latest/controls/keyboard/
      */
-    class SupportsMultipleDevices {
+    class KeyboardMapping : public ControlMapping {
     public:
 
         /**
-         * Constructor which takes the ID of the device
+         * On (Scancode)
          *
-         * @param int id
-         */
-        explicit SupportsMultipleDevices(int id) : deviceId(id) { }
-
-        /**
-         * Returns the (GLFW-assigned) ID of the device
+         * Map a key by its scancode instead of its name, which binds the
+         * physical position of the key, regardless of the keyboard layout.
+         * Scancodes are platform-specific, so they should come from
+         * glfwGetKeyScancode, or from a key the user pressed.
          *
-         * @return int
+         * Scancode mappings take precedence over key mappings. Keys which GLFW
+         * has no key for (GLFW_KEY_UNKNOWN) can only be mapped by scancode.
+         *
+         * @param Event event
+         * @param int scancode
+         * @param std::string signal
+         * @param int mods Modifiers, or anyModifiers to ignore them
+         * @return void
          */
-        [[nodiscard]] int getId() const
+        void onScancode(Event event, int scancode, std::string signal, int mods = anyModifiers)
         {
-            return deviceId;
+            mapScancode(event, scancode, std::move(signal), mods);
         }
 
-        /**
-         * User ID
-         *
-         * Optionally used to distinguish between users/players
-         *
-         * @see https://glfw-inputs.readthedocs.io/en/latest/controls/multiple-joysticks/
-         */
-        std::optional<unsigned int> userId = std::nullopt;
-
-    protected:
-        int deviceId;
-
     };
 
     /**
-     * Supports Dynamic Connectivity
-     *
-     * Interface for control types which have dynamic support of devices
-     * which can be connected and disconnected on-the-fly
+     * Mouse mapping
      *
-     * @see https://glfw-inputs.readthedocs.io/en/latest/misc/control-traits/
+     * @see https://glfw-inputs.readthedocs.io/en/latest/controls/mouse/
      */
-    class SupportsDynamicConnectivity {
+    class MouseMapping : public MotionControlMapping {
 
     };
 
     /**
-     * Keyboard
+     * Joystick mapping
      *
-     * @see https://glfw-inputs.readthedocs.io/en/latest/controls/keyboard/
+     * @see https://glfw-inputs.readthedocs.io/en/latest/controls/joystick/
      */
-    class Keyboard : public Control {
+    class JoystickMapping : public MotionControlMapping {
 
     };
 
     /**
-     * Mouse
+     * Gamepad mapping
      *
-     * @see https://glfw-inputs.readthedocs.io/en/latest/controls/mouse/
+     * @see https://glfw-inputs.readthedocs.io/en/latest/controls/gamepad/
      */
-    class Mouse : public MotionControl {
+    class GamepadMapping : public MotionControlMapping {
 
     };
 
     /**
-     * Joystick
+     * Mapping Context Stack
      *
-     * @see https://glfw-inputs.readthedocs.io/en/latest/controls/joystick/
+     * Mappings layered on top of the mapping of a control, such as a vehicle
+     * or menu mapping on top of the gameplay mapping. Contexts are ordered by
+     * priority, and an input is offered to the contexts which map it, from
+     * the highest priority down, until one consumes it. The mapping of the
+     * control itself comes last.
+     *
+     * Whenever the stack changes, it's compiled into a table holding, for
+     * each (Event, Input), the set of contexts mapping it. Resolving an input
+     * therefore only visits the contexts which map it. The stack has a fixed
+     * capacity, so pushing and popping never allocates.
+     *
+     * @see https://glfw-inputs.readthedocs.io/en/latest/controls/mapping-contexts/
      */
-    class Joystick : public MotionControl,
-            public SupportsMultipleDevices,
-            public SupportsDynamicConnectivity {
+    class MappingContextStack : public Messaging {
     public:
+
         /**
-         * Create Joystick instance
+         * Maximum number of contexts on a stack
+         */
+        static constexpr std::size_t capacity = 16;
+
+        /**
+         * Push a context
          *
-         * @param int id The GLFW-assigned ID of the joystick/gamepad
+         * Contexts with a higher priority come first. Among contexts with the
+         * same priority, the most recently pushed comes first.
+         *
+         * Chords and sequences only work in the mapping of the control,
+         * so mappings with chords or sequences are rejected.
+         *
+         * @param ControlMapping& mapping
+         * @param int priority
+         * @param ContextMode mode
+         * @return void
          */
-        explicit Joystick(int id) : SupportsMultipleDevices(id)
-        {
-            // We need to store device name immediately, because
-            // it cannot be retrieved when disconnected, which is a typical
-            // scenario where you need to know it
-            deviceName = glfwGetJoystickName(getId());
-        }
+        void push(ControlMapping &mapping, int priority = 0, ContextMode mode = ContextMode::Consume);
 
         /**
-         * Returns true if the joystick associated with this connection
-         * is connected
+         * Pop the most recently pushed context
          *
-         * @return bool
+         * @return bool False if the stack is empty
          */
-        [[nodiscard]] bool isConnected() const
-        {
-            return glfwJoystickPresent(getId());
-        }
+        bool pop();
 
         /**
-         * Retrieve the device name (as stored upon creation of the joystick
-         * instance)
+         * Remove the contexts of a mapping
          *
-         * @return std::string
+         * @param const ControlMapping& mapping
+         * @return bool False if the mapping isn't on the stack
          */
-        [[nodiscard]] std::string getDeviceName() const
+        bool remove(const ControlMapping &mapping);
+
+        /**
+         * Replace a mapping by another, keeping the priorities and modes of its contexts
+         *
+         * @param const ControlMapping& from
+         * @param ControlMapping& to
+         * @return bool False if the mapping isn't on the stack
+         */
+        bool replace(const ControlMapping &from, ControlMapping &to);
+
+        /**
+         * Remove all contexts
+         *
+         * @return void
+         */
+        void clear();
+
+        /**
+         * Recompile the table
+         *
+         * Must be called when a mapping on the stack has been modified.
+         * Reports an error if a context has chords or sequences, which are ignored.
+         *
+         * @return void
+         */
+        void compile();
+
+        /**
+         * Resolve an input event
+         *
+         * Invokes onMapped with the MappedInputEvent of each context which maps
+         * the input event, in priority order, until a context consumes it
+         *
+         * Defined in detail/mapping-context-stack.hpp, for use by the Manager
+         *
+         * @param const InputEvent& inputEvent
+         * @param OnMapped onMapped
+         * @return bool True if a context consumed the input event
+         */
+        template<typename OnMapped>
+        bool resolve(const InputEvent &inputEvent, OnMapped onMapped) const;
+
+        /**
+         * Resolve a key which GLFW has no key for, by its scancode only
+         *
+         * Defined in detail/mapping-context-stack.hpp, for use by the Manager
+         *
+         * @param Event event
+         * @param int scancode
+         * @param int mods
+         * @param OnMapped onMapped
+         * @return bool True if a context consumed the event
+         */
+        template<typename OnMapped>
+        bool resolveScancode(Event event, int scancode, int mods, OnMapped onMapped) const;
+
+        [[nodiscard]] std::size_t size() const
         {
-            return deviceName;
+            return count;
+        }
+
+        [[nodiscard]] bool empty() const
+        {
+            return count == 0;
+        }
+
+    private:
+        struct Context {
+            ControlMapping *mapping = nullptr;
+            int priority = 0;
+            ContextMode mode = ContextMode::Consume;
+
+            /**
+             * Increases with every push, to find the most recent context
+             */
+            std::uint64_t order = 0;
+        };
+
+        std::array<Context, capacity> contexts{};
+
+        std::size_t count = 0;
+
+        std::uint64_t nextOrder = 0;
+
+        /**
+         * The contexts (as bits, by position on the stack) mapping each (Event, Input)
+         */
+        std::array<std::uint16_t, eventCount * inputCount> table{};
+
+        /**
+         * The contexts with scancode mappings, which are candidates for all keys
+         */
+        std::uint16_t scancodeContexts = 0;
+
+        void erase(std::size_t position);
+
+    };
+
+    /**
+     * Control
+     *
+     * The base of the controls (keyboard, mouse, joystick)
+     */
+    class Control {
+    public:
+
+        /**
+         * Handle input event
+         *
+         * Keeps track of the down-states of buttons
+         *
+         * @param InputEvent inputEvent
+         * @return void
+         */
+        virtual void handle(InputEvent inputEvent)
+        {
+            if (inputEvent.event == Event::ButtonPress) {
+                buttonsDown.set(inputEvent.input, true);
+            } else if (inputEvent.event == Event::ButtonRelease) {
+                buttonsDown.set(inputEvent.input, false);
+            }
+            mods = inputEvent.mods;
+        }
+
+        /**
+         * Returns the modifiers held during the most recent button event
+         *
+         * @return int
+         */
+        [[nodiscard]] int getMods() const
+        {
+            return mods;
+        }
+
+        /**
+         * Returns the scancode of a held key, or 0
+         *
+         * @param Input input
+         * @return int
+         */
+        [[nodiscard]] virtual int getScancode([[maybe_unused]] Input input) const
+        {
+            return 0;
+        }
+
+        /**
+         * Returns true if the button is currently pressed down
+         *
+         * @param Input input
+         * @return bool
+         */
+        [[nodiscard]] bool isDown(Input input) const
+        {
+            return buttonsDown.test(input);
         }
 
+        /**
+         * Get the set of buttons currently pressed down
+         *
+         * Unlike getButtonsDown, this doesn't allocate. The set can be iterated
+         * to visit the held buttons (as Input values) in ascending order.
+         *
+         * @see https://glfw-inputs.readthedocs.io/en/latest/getting-started/button-down-states/
+         * @return const ButtonSet<inputCount>&
+         */
+        [[nodiscard]] const ButtonSet<inputCount> &getHeldButtons() const
+        {
+            return buttonsDown;
+        }
+
+        /**
+         * Get buttons currently pressed down
+         *
+         * @see https://glfw-inputs.readthedocs.io/en/latest/getting-started/button-down-states/
+         * @return std::vector<int>
+         */
+        [[nodiscard]] std::vector<int> getButtonsDown() const
+        {
+            std::vector<int> list;
+            for (std::size_t input : buttonsDown) {
+                list.push_back(static_cast<int>(input));
+            }
+            return list;
+        }
+
+        std::optional<ControlMapping *> mapping = std::nullopt;
+
+        /**
+         * Mappings layered on top of the mapping
+         */
+        MappingContextStack contexts;
+
+        /**
+         * The progress of the chords and sequences of the mapping
+         */
+        ComboStates comboStates;
+
     protected:
-        std::string deviceName;
+        ButtonSet<inputCount> buttonsDown;
+
+        int mods = 0;
 
     };
 
     /**
-     * Joystick Manager
+     * Motion Control
      *
-     * A class which assists with managing multiple joystick/gamepad
-     * devices within the same application
+     * An extension of the Control class which includes motion surfaces
+     * such as the mouse cursor, mouse wheel and joystick axes
      *
-     * @see https://glfw-inputs.readthedocs.io/en/latest/controls/multiple-joysticks/
+     * @see https://glfw-inputs.readthedocs.io/en/latest/getting-started/motion-controls/
      */
-    class JoystickManager {
+    class MotionControl : public Control {
     public:
 
         /**
-         * Creates a vector of all currently connected joysticks/gamepads
+         * Position changed
          *
-         * @return std::vector<Joystick>
+         * Used when a control has a fixed position, such as the mouse cursor
+         *
+         * @param Position position
+         * @param MotionSurface surface
+         * @param Timestamp timestamp Time at which the position was captured
+         * @param MotionSamples samples The coalesced samples (in coalesced motion mode)
+         * @return void
          */
-        [[nodiscard]] std::vector<Joystick> createJoystickInstances() const
+        void positionChanged(Position position,
+                             MotionSurface surface,
+                             Timestamp timestamp = Clock::now(),
+                             MotionSamples samples = {})
         {
-            std::vector<Joystick> list;
-            for (int i = 0; i <= maxJoysticks - 1; i++) {
-                if (glfwJoystickPresent(GLFW_JOYSTICK_1 + i)) {
-                    list.emplace_back(GLFW_JOYSTICK_1 + i);
+            SurfaceState &state = surfaces[static_cast<std::size_t>(surface)];
+
+            // There's no relative movement on the first position of a surface
+            std::optional<Position> relative;
+            if (state.valid) {
+                relative = Position{
+                    .x = position.x - state.last.x,
+                    .y = position.y - state.last.y,
+                    .z = std::nullopt,
+                };
+                if (state.last.z.has_value() && position.z.has_value()) {
+                    relative->z = position.z.value() - state.last.z.value();
                 }
             }
-            return list;
+
+            state.last = position;
+            state.valid = true;
+
+            if (mapping.has_value() && mapping.value()->onMove.has_value()) {
+                mapping.value()->onMove.value()({
+                    .position = position,
+                    .relative = relative,
+                    .surface = surface,
+                    .timestamp = timestamp,
+                    .samples = samples,
+                });
+            }
         }
 
-    private:
         /**
-         * The maximum joysticks which can be handled with GLFW
-         * This is based on the existence of the GLFW_JOYSTICK_16 constant
+         * Axes changed
+         *
+         * Used for analog axes, such as joystick sticks. The position is
+         * filtered with the AxisFilter of the mapping, and only dispatched
+         * (with positionChanged) if it differs from the previous position.
+         *
+         * The triggers of gamepads are independent axes (from 0 to 1),
+         * so they always use an axial deadzone.
+         *
+         * @param Position position The raw axis values
+         * @param MotionSurface surface
+         * @param Timestamp timestamp Time at which the axes were read
+         * @return Position The filtered position
          */
-        unsigned int maxJoysticks = 16;
+        Position axesChanged(Position position, MotionSurface surface, Timestamp timestamp);
+
+        /**
+         * Returns true if an axis threshold of the mapping is currently passed
+         *
+         * @param std::size_t index Index in MotionControlMapping::getAxisThresholds
+         * @return bool
+         */
+        [[nodiscard]] bool isAxisThresholdPassed(std::size_t index) const
+        {
+            return index < axisThresholdStates.size() && axisThresholdStates[index];
+        }
+
+        /**
+         * Set the state of an axis threshold of the mapping
+         *
+         * @param std::size_t index Index in MotionControlMapping::getAxisThresholds
+         * @param bool passed
+         * @return void
+         */
+        void setAxisThresholdPassed(std::size_t index, bool passed)
+        {
+            if (index >= axisThresholdStates.size()) {
+                axisThresholdStates.resize(index + 1, 0);
+            }
+            axisThresholdStates[index] = passed;
+        }
+
+        /**
+         * Reset the states of the axis thresholds, such as when the mapping is replaced
+         *
+         * @return void
+         */
+        void resetAxisThresholds()
+        {
+            std::fill(axisThresholdStates.begin(), axisThresholdStates.end(), 0);
+        }
+
+        /**
+         * Relative changed
+         *
+         * Used when the position of the control isn't relevant, for instance
+         * applicable for the mouse wheel
+         *
+         * @param Position relative
+         * @param MotionSurface surface
+         * @param Timestamp timestamp Time at which the movement was captured
+         * @param MotionSamples samples The coalesced samples (in coalesced motion mode)
+         * @return void
+         */
+        void relativeChanged(Position relative,
+                             MotionSurface surface,
+                             Timestamp timestamp = Clock::now(),
+                             MotionSamples samples = {})
+        {
+            SurfaceState &state = surfaces[static_cast<std::size_t>(surface)];
+            state.accumulated.x += relative.x;
+            state.accumulated.y += relative.y;
+
+            if (mapping.has_value() && mapping.value()->onMove.has_value()) {
+                mapping.value()->onMove.value()({
+                    .position = std::nullopt,
+                    .relative = relative,
+                    .surface = surface,
+                    .timestamp = timestamp,
+                    .samples = samples,
+                });
+            }
+        }
+
+        /**
+         * Returns the latest position of a surface, if it has been moved
+         *
+         * @param MotionSurface surface
+         * @return std::optional<Position>
+         */
+        [[nodiscard]] std::optional<Position> getPosition(MotionSurface surface) const
+        {
+            const SurfaceState &state = surfaces[static_cast<std::size_t>(surface)];
+            if (!state.valid) {
+                return std::nullopt;
+            }
+            return state.last;
+        }
+
+        /**
+         * Returns the sum of the relative movements of a surface since
+         * the previous call, and starts a new sum
+         *
+         * @param MotionSurface surface
+         * @return Position
+         */
+        Position takeRelative(MotionSurface surface)
+        {
+            SurfaceState &state = surfaces[static_cast<std::size_t>(surface)];
+            Position relative = state.accumulated;
+            state.accumulated = {};
+            return relative;
+        }
+
+        std::optional<MotionControlMapping *> mapping = std::nullopt;
+
+    protected:
+        /**
+         * The latest position of a surface, and the sum of its relative
+         * movements (for surfaces without a position)
+         */
+        struct SurfaceState {
+            Position last{};
+            Position accumulated{};
+            bool valid = false;
+        };
+
+        std::array<SurfaceState, motionSurfaceCount> surfaces{};
+
+        std::array<AxisFilterState, motionSurfaceCount> filterStates{};
+        std::array<Timestamp, motionSurfaceCount> filterTimes{};
+
+        std::vector<unsigned char> axisThresholdStates;
+
+    };
+
+    /**
+     * Supports Multiple Devices
+     *
+     * Trait for control types with support for multiple
+     * devices at the same time such as joysticks and gamepads
+     *
+     * @see https://glfw-inputs.readthedocs.io/en/latest/misc/control-traits/
+     */
+    class SupportsMultipleDevices {
+    public:
+
+        /**
+         * Constructor which takes the ID of the device
+         *
+         * @param int id
+         */
+        explicit SupportsMultipleDevices(int id) : deviceId(id) { }
+
+        /**
+         * Returns the (GLFW-assigned) ID of the device
+         *
+         * @return int
+         */
+        [[nodiscard]] int getId() const
+        {
+            return deviceId;
+        }
+
+        /**
+         * User ID
+         *
+         * Optionally used to distinguish between users/players
+         *
+         * @see https://glfw-inputs.readthedocs.io/en/latest/controls/multiple-joysticks/
+         */
+        std::optional<unsigned int> userId = std::nullopt;
+
+    protected:
+        int deviceId;
+
+    };
+
+    /**
+     * Supports Dynamic Connectivity
+     *
+     * Interface for control types which have dynamic support of devices
+     * which can be connected and disconnected on-the-fly
+     *
+     * @see https://glfw-inputs.readthedocs.io/en/latest/misc/control-traits/
+     */
+    class SupportsDynamicConnectivity {
+
+    };
+
+    class Manager;
+
+    /**
+     * Input Backend
+     *
+     * The source of inputs for the Manager, and of device state for
+     * joysticks and gamepads. GlfwBackend, which talks to GLFW, is the default.
+     * SyntheticBackend can be used to inject inputs without a display
+     * or physical devices, for example in tests, replays and load tests.
+     *
+     * @see https://glfw-inputs.readthedocs.io/en/latest/controls/input-backend/
+     */
+    class InputBackend {
+    public:
+        virtual ~InputBackend() = default;
+
+        /**
+         * Start delivering inputs to a manager, by calling its
+         * onKeyboard, onMouseButton, onMouseMove, onMouseWheel and
+         * onJoystickConnection handlers
+         *
+         * @param Manager& manager
+         * @return void
+         */
+        virtual void attach(Manager &manager) = 0;
+
+        /**
+         * Stop delivering inputs to a manager
+         *
+         * @param Manager& manager
+         * @return void
+         */
+        virtual void detach(Manager &manager) = 0;
+
+        /**
+         * @param int jid
+         * @return bool True if the joystick is connected
+         */
+        virtual bool joystickPresent(int jid) = 0;
+
+        /**
+         * @param int jid
+         * @return const char* nullptr if the joystick isn't connected
+         */
+        virtual const char *joystickName(int jid) = 0;
+
+        /**
+         * @param int jid
+         * @param int* count Receives the number of buttons
+         * @return const unsigned char* Button states, nullptr if the joystick isn't connected
+         */
+        virtual const unsigned char *joystickButtons(int jid, int *count) = 0;
+
+        /**
+         * @param int jid
+         * @param int* count Receives the number of axes
+         * @return const float* Axis values, nullptr if the joystick isn't connected
+         */
+        virtual const float *joystickAxes(int jid, int *count) = 0;
+
+        /**
+         * @param int jid
+         * @return const char* nullptr if the joystick isn't a connected gamepad
+         */
+        virtual const char *gamepadName(int jid) = 0;
+
+        /**
+         * @param int jid
+         * @param GLFWgamepadstate* state Receives the state
+         * @return bool False if the joystick isn't a connected gamepad
+         */
+        virtual bool gamepadState(int jid, GLFWgamepadstate *state) = 0;
+
+        /**
+         * Enable or disable raw (unaccelerated) mouse motion, with
+         * the cursor hidden and locked to the window
+         *
+         * @param bool enabled
+         * @return bool False if raw mouse motion isn't supported
+         */
+        virtual bool setRawMouseMotion([[maybe_unused]] bool enabled)
+        {
+            return false;
+        }
+
+    };
+
+    /**
+     * The backend used by controls when none is specified (a GlfwBackend)
+     *
+     * @return InputBackend&
+     */
+    InputBackend &defaultBackend();
+
+    /**
+     * Keyboard
+     *
+     * @see https://glfw-inputs.readthedocs.io/en/latest/controls/keyboard/
+     */
+    class Keyboard : public Control {
+    public:
+
+        /**
+         * Handle input event
+         *
+         * Also remembers the scancodes of pressed keys, so the
+         * Event::ButtonDown of scancode mappings can be found
+         *
+         * @param InputEvent inputEvent
+         * @return void
+         */
+        void handle(InputEvent inputEvent) override
+        {
+            Control::handle(inputEvent);
+            if (inputEvent.event == Event::ButtonPress) {
+                scancodes[inputEvent.input] = inputEvent.scancode;
+            }
+        }
+
+        [[nodiscard]] int getScancode(Input input) const override
+        {
+            return buttonsDown.test(input) ? scancodes[input] : 0;
+        }
+
+        /**
+         * Handle a key which GLFW has no key for (GLFW_KEY_UNKNOWN)
+         *
+         * Such keys aren't an Input, so their down-states are
+         * kept by scancode instead
+         *
+         * @param Event event
+         * @param int scancode
+         * @param int eventMods
+         * @return void
+         */
+        void handleScancode(Event event, int scancode, int eventMods)
+        {
+            auto held = std::find(heldScancodes.begin(), heldScancodes.end(), scancode);
+            if (event == Event::ButtonPress && held == heldScancodes.end()) {
+                heldScancodes.push_back(scancode);
+            } else if (event == Event::ButtonRelease && held != heldScancodes.end()) {
+                heldScancodes.erase(held);
+            }
+            mods = eventMods;
+        }
+
+        /**
+         * Returns the scancodes of the held keys which GLFW has no key for
+         *
+         * @return const std::vector<int>&
+         */
+        [[nodiscard]] const std::vector<int> &getHeldScancodes() const
+        {
+            return heldScancodes;
+        }
+
+    private:
+        std::array<int, inputCount> scancodes{};
+
+        std::vector<int> heldScancodes;
+
+    };
+
+    /**
+     * Mouse
+     *
+     * @see https://glfw-inputs.readthedocs.io/en/latest/controls/mouse/
+     */
+    class Mouse : public MotionControl {
+    public:
+
+        /**
+         * Raw moved
+         *
+         * Accumulates an unaccelerated movement, in raw mouse motion mode.
+         * Called by the Manager.
+         *
+         * @param double x
+         * @param double y
+         * @return void
+         */
+        void rawMoved(double x, double y)
+        {
+            rawAccumulated.x += x;
+            rawAccumulated.y += y;
+            rawPending = true;
+        }
+
+        /**
+         * Raw tick
+         *
+         * The movement accumulated since the previous tick becomes the raw
+         * delta, and is delivered to onMove (MotionSurface::MouseRaw).
+         * Called by the Manager on every tick.
+         *
+         * @param Timestamp timestamp
+         * @return void
+         */
+        void rawTick(Timestamp timestamp)
+        {
+            rawDelta = rawAccumulated;
+            rawAccumulated = {};
+
+            if (rawPending) {
+                rawPending = false;
+                relativeChanged(rawDelta, MotionSurface::MouseRaw, timestamp);
+            }
+        }
+
+        /**
+         * Returns the unaccelerated movement of the latest tick,
+         * in raw mouse motion mode
+         *
+         * @return Position
+         */
+        [[nodiscard]] Position getRawDelta() const
+        {
+            return rawDelta;
+        }
+
+    protected:
+        Position rawAccumulated{}, rawDelta{};
+
+        bool rawPending = false;
+
+    };
+
+    /**
+     * Joystick
+     *
+     * @see https://glfw-inputs.readthedocs.io/en/latest/controls/joystick/
+     */
+    class Joystick : public MotionControl,
+            public SupportsMultipleDevices,
+            public SupportsDynamicConnectivity {
+    public:
+        /**
+         * Create Joystick instance
+         *
+         * @param int id The GLFW-assigned ID of the joystick/gamepad
+         * @param InputBackend& backend The backend providing the joystick state
+         */
+        explicit Joystick(int id, InputBackend &backend = defaultBackend())
+            : SupportsMultipleDevices(id), backend(&backend)
+        {
+            // We need to store device name immediately, because
+            // it cannot be retrieved when disconnected, which is a typical
+            // scenario where you need to know it
+            // The name is nullptr when no joystick is present
+            if (const char *name = backend.joystickName(getId())) {
+                deviceName = name;
+            }
+        }
+
+        /**
+         * Returns true if the joystick associated with this connection
+         * is connected
+         *
+         * @return bool
+         */
+        [[nodiscard]] bool isConnected() const
+        {
+            return backend->joystickPresent(getId());
+        }
+
+        /**
+         * Read the current button states
+         *
+         * @param int* count Receives the number of buttons
+         * @return const unsigned char* nullptr if the joystick isn't connected
+         */
+        const unsigned char *readButtons(int *count) const
+        {
+            return backend->joystickButtons(getId(), count);
+        }
+
+        /**
+         * Read the current axis values
+         *
+         * @param int* count Receives the number of axes
+         * @return const float* nullptr if the joystick isn't connected
+         */
+        const float *readAxes(int *count) const
+        {
+            return backend->joystickAxes(getId(), count);
+        }
+
+        /**
+         * Retrieve the device name (as stored upon creation of the joystick
+         * instance)
+         *
+         * @return std::string
+         */
+        [[nodiscard]] std::string getDeviceName() const
+        {
+            return deviceName;
+        }
+
+    protected:
+        std::string deviceName;
+
+        InputBackend *backend;
+
+    };
+
+    /**
+     * Gamepad
+     *
+     * A joystick with a standardized layout (as provided by GLFW's gamepad mappings),
+     * which makes buttons and axes consistent across controller models
+     *
+     * @see https://glfw-inputs.readthedocs.io/en/latest/controls/gamepad/
+     */
+    class Gamepad : public MotionControl,
+            public SupportsMultipleDevices,
+            public SupportsDynamicConnectivity {
+    public:
+        /**
+         * Create Gamepad instance
+         *
+         * @param int id The GLFW-assigned ID of the joystick/gamepad
+         * @param InputBackend& backend The backend providing the gamepad state
+         */
+        explicit Gamepad(int id, InputBackend &backend = defaultBackend())
+            : SupportsMultipleDevices(id), backend(&backend)
+        {
+            // Stored immediately, because it cannot be retrieved when disconnected
+            if (const char *name = backend.gamepadName(getId())) {
+                deviceName = name;
+            }
+        }
+
+        /**
+         * Read the current state of the gamepad
+         *
+         * Retrieves all buttons and axes with a single call to the backend
+         * (glfwGetGamepadState). Called by the Manager once per tick,
+         * unless it's in buffered mode.
+         *
+         * @return bool False if the gamepad is disconnected, or has no gamepad mapping
+         */
+        bool update()
+        {
+            connected = readState(&state);
+            return connected;
+        }
+
+        /**
+         * Set the state of the gamepad, as read earlier with readState
+         *
+         * Used by the Manager in buffered mode, with the state read by Manager::poll
+         *
+         * @param bool isConnected
+         * @param const GLFWgamepadstate& polledState
+         * @return bool isConnected
+         */
+        bool update(bool isConnected, const GLFWgamepadstate &polledState)
+        {
+            connected = isConnected;
+            state = polledState;
+            return connected;
+        }
+
+        /**
+         * Read the current state of the gamepad, without storing it
+         *
+         * @param GLFWgamepadstate* polledState Receives the state
+         * @return bool False if the gamepad is disconnected, or has no gamepad mapping
+         */
+        bool readState(GLFWgamepadstate *polledState) const
+        {
+            return backend->gamepadState(getId(), polledState);
+        }
+
+        /**
+         * Returns true if the gamepad was connected on the last update
+         *
+         * @return bool
+         */
+        [[nodiscard]] bool isConnected() const
+        {
+            return connected;
+        }
+
+        /**
+         * The state of buttons and axes, as read on the last update
+         *
+         * @return const GLFWgamepadstate&
+         */
+        [[nodiscard]] const GLFWgamepadstate &getState() const
+        {
+            return state;
+        }
+
+        /**
+         * Retrieve the device name (as stored upon creation of the gamepad instance)
+         *
+         * @return std::string
+         */
+        [[nodiscard]] std::string getDeviceName() const
+        {
+            return deviceName;
+        }
+
+    protected:
+        std::string deviceName;
+
+        GLFWgamepadstate state{};
+
+        bool connected = false;
+
+        InputBackend *backend;
+
+    };
+
+    /**
+     * Joystick Manager
+     *
+     * A class which assists with managing multiple joystick/gamepad
+     * devices within the same application
+     *
+     * @see https://glfw-inputs.readthedocs.io/en/latest/controls/multiple-joysticks/
+     */
+    class JoystickManager {
+    public:
+
+        /**
+         * Creates a vector of all currently connected joysticks/gamepads
+         *
+         * @param InputBackend& backend
+         * @return std::vector<Joystick>
+         */
+        [[nodiscard]] std::vector<Joystick> createJoystickInstances(InputBackend &backend = defaultBackend()) const
+        {
+            std::vector<Joystick> list;
+            for (int i = 0; i < static_cast<int>(maxJoysticks); i++) {
+                if (backend.joystickPresent(GLFW_JOYSTICK_1 + i)) {
+                    list.emplace_back(GLFW_JOYSTICK_1 + i, backend);
+                }
+            }
+            return list;
+        }
+
+    private:
+        /**
+         * The maximum joysticks which can be handled with GLFW
+         * This is based on the existence of the GLFW_JOYSTICK_16 constant
+         */
+        unsigned int maxJoysticks = 16;
+
+    };
+
+    /**
+     * Received signal
+     *
+     * Struct used for callbacks
+     *
+     * @see https://glfw-inputs.readthedocs.io/en/latest/misc/received-signal/
+     */
+    struct ReceivedSignal {
+        std::string_view signal;
+        SignalId signalId;
+        std::optional<SupportsMultipleDevices*> device;
+        Timestamp timestamp;
+    };
+
+    /**
+     * Subscription
+     *
+     * Token returned when listening for a signal, which can later
+     * be used to stop listening
+     */
+    struct Subscription {
+        SignalId signalId = 0;
+        std::uint32_t id = 0;
+
+        /**
+         * Returns true if the token refers to a subscription
+         *
+         * @return bool
+         */
+        [[nodiscard]] bool isValid() const
+        {
+            return id != 0;
+        }
+    };
+
+    /**
+     * Signal Handler
+     *
+     * Callback invoked with each received signal. A small-buffer
+     * delegate, so most lambdas are stored without allocating.
+     */
+    using SignalHandler = Delegate<void(ReceivedSignal)>;
+
+    /**
+     * Action Snapshot
+     *
+     * What happened to each signal during a tick, in dense arrays indexed
+     * by SignalId: whether it was pressed, held or released, and the value
+     * of mapped axes. An alternative to listening for signals, for code
+     * which prefers to query the state of the actions once per frame.
+     *
+     * A published snapshot isn't modified, so any number of threads can
+     * read it without locking.
+     *
+     * @see https://glfw-inputs.readthedocs.io/en/latest/controls/action-snapshot/
+     */
+    class ActionSnapshot {
+    public:
+
+        /**
+         * Returns true if a ButtonPress mapped to the signal happened during the tick
+         * (also set by chords, sequences and device events)
+         *
+         * @param SignalId signalId
+         * @return bool
+         */
+        [[nodiscard]] bool isPressed(SignalId signalId) const
+        {
+            return test(signalId, pressed);
+        }
+
+        /**
+         * Returns true if a ButtonDown mapped to the signal happened during the tick
+         *
+         * @param SignalId signalId
+         * @return bool
+         */
+        [[nodiscard]] bool isHeld(SignalId signalId) const
+        {
+            return test(signalId, held);
+        }
+
+        /**
+         * Returns true if a ButtonRelease mapped to the signal happened during the tick
+         *
+         * @param SignalId signalId
+         * @return bool
+         */
+        [[nodiscard]] bool isReleased(SignalId signalId) const
+        {
+            return test(signalId, released);
+        }
+
+        /**
+         * Returns true if the signal has a value (is mapped with onAxis)
+         *
+         * @param SignalId signalId
+         * @return bool
+         */
+        [[nodiscard]] bool hasValue(SignalId signalId) const
+        {
+            return test(signalId, valued);
+        }
+
+        /**
+         * Returns the value of a signal mapped with onAxis
+         *
+         * @param SignalId signalId
+         * @return Position {0, 0} if the signal has no value
+         */
+        [[nodiscard]] Position getValue(SignalId signalId) const
+        {
+            if (!hasValue(signalId)) {
+                return {};
+            }
+            return values[signalId];
+        }
+
+        /**
+         * Returns the number of the tick which produced the snapshot, starting at 1
+         *
+         * @return std::uint64_t
+         */
+        [[nodiscard]] std::uint64_t getFrame() const
+        {
+            return frame;
+        }
+
+        /**
+         * Returns the time of the tick which produced the snapshot
+         *
+         * @return Timestamp
+         */
+        [[nodiscard]] Timestamp getTimestamp() const
+        {
+            return timestamp;
+        }
+
+    private:
+        friend class ActionSnapshotBuffer;
+
+        static constexpr std::uint8_t pressed = 1;
+        static constexpr std::uint8_t held = 2;
+        static constexpr std::uint8_t released = 4;
+        static constexpr std::uint8_t valued = 8;
+
+        std::vector<std::uint8_t> states;
+
+        std::vector<Position> values;
+
+        std::uint64_t frame = 0;
+
+        Timestamp timestamp;
+
+        [[nodiscard]] bool test(SignalId signalId, std::uint8_t state) const
+        {
+            return signalId < states.size() && (states[signalId] & state) != 0;
+        }
+
+    };
+
+    /**
+     * Input Recorder
+     *
+     * Records the inputs processed by a Manager into a compact binary
+     * stream, which can be replayed with InputPlayer. The recording is
+     * written through a fixed-size buffer, so memory usage stays bounded
+     * regardless of the length of the session.
+     *
+     * Records consist of a type, the time since the previous record
+     * (in nanoseconds, as a variable-length integer) and a payload.
+     * Joystick and gamepad states are only recorded when they change.
+     *
+     * @see https://glfw-inputs.readthedocs.io/en/latest/misc/recording/
+     */
+    class InputRecorder {
+    public:
+        /**
+         * Identifies the format at the beginning of the stream
+         */
+        static constexpr char magic[4] = {'G', 'L', 'I', 'R'};
+
+        static constexpr std::uint8_t version = 1;
+
+        /**
+         * Start a recording
+         *
+         * The stream should be opened in binary mode, and must outlive the recorder
+         *
+         * @param std::ostream& stream
+         * @param std::size_t bufferSize Number of bytes buffered before writing to the stream (at least 16)
+         */
+        explicit InputRecorder(std::ostream &stream, std::size_t bufferSize = 64 * 1024);
+
+        InputRecorder(const InputRecorder &) = delete;
+
+        InputRecorder &operator=(const InputRecorder &) = delete;
+
+        ~InputRecorder();
+
+        /**
+         * Record a raw input
+         *
+         * @param const RawInput& rawInput
+         * @param const char* deviceName Name of the connected joystick (for joystick connections)
+         * @return void
+         */
+        void recordInput(const RawInput &rawInput, const char *deviceName = nullptr);
+
+        /**
+         * Record the button and axis states of a joystick
+         *
+         * Nothing is written if the state is unchanged since it was last recorded
+         *
+         * @param int jid
+         * @param const unsigned char* buttons
+         * @param int buttonCount
+         * @param const float* axes
+         * @param int axisCount
+         * @param Timestamp timestamp
+         * @return void
+         */
+        void recordJoystick(int jid,
+                            const unsigned char *buttons,
+                            int buttonCount,
+                            const float *axes,
+                            int axisCount,
+                            Timestamp timestamp);
+
+        /**
+         * Record the state of a gamepad
+         *
+         * Nothing is written if the state is unchanged since it was last recorded
+         *
+         * @param int jid
+         * @param const GLFWgamepadstate& state
+         * @param Timestamp timestamp
+         * @return void
+         */
+        void recordGamepad(int jid, const GLFWgamepadstate &state, Timestamp timestamp);
+
+        /**
+         * Record the end of a tick (frame)
+         *
+         * @param Timestamp timestamp The timestamp of the tick
+         * @return void
+         */
+        void recordTick(Timestamp timestamp);
+
+        /**
+         * Write the buffered records to the stream
+         *
+         * Also done when the recorder is destroyed
+         *
+         * @return void
+         */
+        void flush();
+
+    private:
+        struct Impl;
+
+        /**
+         * The buffered writer, and the last recorded state of each device
+         */
+        std::unique_ptr<Impl> impl;
+
+    };
+
+    /**
+     * Input Manager
+     *
+     * The input manager class which first and foremost connects with GLFW,
+     * but also handles all callbacks (i.e. communication with GLFW when inputs
+     * are interacted with).
+     *
+     * Class is also responsible for listening for signals, and exposing the
+     * option to receive those signals to the library consumer.
+     *
+     * @see https://glfw-inputs.readthedocs.io/en/latest/controls/input-manager/
+     */
+    class Manager : public Messaging {
+    public:
+
+        /**
+         * Create a new instance of the input manager
+         *
+         * The manager receives inputs from the window through a GlfwBackend,
+         * which registers the manager as the user pointer of the window
+         * (glfwSetWindowUserPointer). Each window should therefore
+         * have its own manager.
+         *
+         * @param GLFWwindow* window
+         */
+        explicit Manager(GLFWwindow *window);
+
+        /**
+         * Create a new instance of the input manager, which receives
+         * inputs from the provided backend
+         *
+         * The backend must outlive the manager.
+         *
+         * @param InputBackend& backend
+         */
+        explicit Manager(InputBackend &backend);
+
+        Manager(const Manager &) = delete;
+
+        Manager &operator=(const Manager &) = delete;
+
+        /**
+         * Detaches the manager from its backend
+         */
+        ~Manager();
+
+        /**
+         * Joystick connection handler
+         *
+         * @param int jid Joystick (device) ID
+         * @param int event GLFW event ID
+         * @return void
+         */
+        void onJoystickConnection(int jid, int event);
+
+        /**
+         * Mouse/cursor movement handler
+         *
+         * @param double x
+         * @param double y
+         * @return void
+         */
+        void onMouseMove(double x, double y);
+
+        /**
+         * Mouse/scroll wheel handler
+         *
+         * @param double x
+         * @param double y
+         * @return void
+         */
+        void onMouseWheel(double x, double y);
+
+        /**
+         * Mouse button handler
+         *
+         * @param int button
+         * @param int action
+         * @param int mods
+         * @return void
+         */
+        void onMouseButton(int button, int action, int mods);
+
+        /**
+         * Keyboard button press handler
+         *
+         * @param int key
+         * @param int scancode
+         * @param int action
+         * @param int mods
+         * @return void
+         */
+        void onKeyboard(int key, int scancode, int action, int mods);
+
+        /**
+         * Submit raw input
+         *
+         * In buffered mode the input is queued until the next drain (or tick),
+         * otherwise it's processed immediately
+         *
+         * @param const RawInput& rawInput
+         * @param const char* deviceName The name of the joystick, for joystick connections
+         * @return void
+         */
+        void submit(const RawInput &rawInput, const char *deviceName = nullptr);
+
+        /**
+         * Process raw input
+         *
+         * Forwards the input to the handling of its type
+         *
+         * @param const RawInput& rawInput
+         * @param const char* deviceName The name of the joystick, for joystick connections
+         * @return void
+         */
+        void process(const RawInput &rawInput, const char *deviceName);
+
+        /**
+         * Set buffered mode
+         *
+         * In buffered mode, the GLFW callbacks only queue the inputs in a
+         * lock-free single-producer/single-consumer ring buffer, and the signals
+         * are dispatched when drain (or tick) is called. This keeps the work
+         * of the signal callbacks out of glfwPollEvents, and allows the
+         * inputs to be consumed on another thread than the one polling events.
+         *
+         * GLFW only allows joysticks and gamepads to be read on the main thread,
+         * so in buffered mode they are read by poll, which must be called on the
+         * thread polling events, after glfwPollEvents. The next tick handles the
+         * states read by the latest poll, and never calls GLFW itself.
+         *
+         * Inputs received while the buffer is full are dropped, and reported
+         * as a warning on the next drain.
+         *
+         * Must not be changed while events are being polled or drained.
+         *
+         * @param bool enabled
+         * @param std::size_t capacity Maximum number of queued inputs
+         * @return void
+         */
+        void setBuffered(bool enabled, std::size_t capacity = 4096);
+
+        /**
+         * Returns true if the manager is in buffered mode
+         *
+         * @return bool
+         */
+        [[nodiscard]] bool isBuffered() const
+        {
+            return buffered;
+        }
+
+        /**
+         * Poll
+         *
+         * Reads the state of the joysticks and gamepads in buffered mode,
+         * for the next tick. Must be called on the thread polling events
+         * (the main thread, with GLFW), after glfwPollEvents. Does nothing
+         * when not in buffered mode, where tick reads them itself.
+         *
+         * The joysticks and gamepads must not be changed while polling.
+         *
+         * @return void
+         */
+        void poll();
+
+        /**
+         * Drain
+         *
+         * Processes the inputs queued in buffered mode, in the
+         * order they were received. Called automatically by tick.
+         *
+         * @return void
+         */
+        void drain();
+
+        /**
+         * Process joystick connection
+         *
+         * @param int jid Joystick (device) ID
+         * @param int event GLFW event ID
+         * @param Timestamp timestamp
+         * @return void
+         */
+        void processJoystickConnection(int jid, int event, Timestamp timestamp);
+
+        /**
+         * Process mouse/cursor movement
+         *
+         * @param double x
+         * @param double y
+         * @param Timestamp timestamp
+         * @return void
+         */
+        void processMouseMove(double x, double y, Timestamp timestamp);
+
+        /**
+         * Process mouse/scroll wheel movement
+         *
+         * @param double x
+         * @param double y
+         * @param Timestamp timestamp
+         * @return void
+         */
+        void processMouseWheel(double x, double y, Timestamp timestamp);
+
+        /**
+         * Process mouse button
+         *
+         * Note: The handling code cannot be put into a helper method because the
+         * differences between Control and MotionControl would be sliced, and it
+         * would point to the incorrect mapping
+         *
+         * @param int button
+         * @param int action
+         * @param int mods
+         * @param Timestamp timestamp
+         * @return void
+         */
+        void processMouseButton(int button, int action, int mods, Timestamp timestamp);
+
+        /**
+         * Process keyboard button press
+         *
+         * @param int key
+         * @param int scancode
+         * @param int action
+         * @param int mods
+         * @param Timestamp timestamp
+         * @return void
+         */
+        void processKeyboard(int key, int scancode, int action, int mods, Timestamp timestamp);
+
+        /**
+         * Handle mapped device events
+         *
+         * Helper method to find a specific signal and invoke its callback
+         *
+         * @param const MappedDeviceEvent* mappedDeviceEvent
+         * @param SupportsMultipleDevices* device
+         * @param Timestamp timestamp
+         * @return void
+         */
+        void handleMappedDeviceEvent(const MappedDeviceEvent *mappedDeviceEvent, SupportsMultipleDevices* device, Timestamp timestamp);
+
+        /**
+         * Handle mapped input events
+         *
+         * Helper method to find a specific signal and invoke its callback
+         *
+         * @param const MappedInputEvent* mappedInputEvent
+         * @param Timestamp timestamp Time at which the input was captured
+         * @return void
+         */
+        void handleMappedInputEvent(const MappedInputEvent *mappedInputEvent, Timestamp timestamp);
+
+        /**
+         * Handle input event
+         *
+         * Resolves an input event through the mapping contexts of a control,
+         * and then its mapping, unless a context consumed it
+         *
+         * @param Control* control
+         * @param const ControlMapping* mapping The mapping of the control, or nullptr
+         * @param const InputEvent& inputEvent
+         * @return void
+         */
+        void handleInputEvent(Control *control, const ControlMapping *mapping, const InputEvent &inputEvent);
+
+        /**
+         * Handle scancode event
+         *
+         * Resolves an event of a key which GLFW has no key for through the
+         * scancode mappings of the mapping contexts of the keyboard, and
+         * then its mapping, unless a context consumed it
+         *
+         * @param Event event
+         * @param int scancode
+         * @param int mods
+         * @param Timestamp timestamp
+         * @return void
+         */
+        void handleScancodeEvent(Event event, int scancode, int mods, Timestamp timestamp);
+
+        /**
+         * Handle combos
+         *
+         * Advances the chords and sequences of a control on button presses
+         *
+         * @param Control* control
+         * @param const ControlMapping* mapping
+         * @param const InputEvent& inputEvent
+         * @return void
+         */
+        void handleCombos(Control *control, const ControlMapping *mapping, const InputEvent &inputEvent);
+
+        /**
+         * Dispatch a signal
+         *
+         * Invokes the callbacks registered for the signal, which are
+         * found by indexing on its SignalId, and records it in the
+         * action snapshot
+         *
+         * @param Event event The event which produced the signal
+         * @param const ReceivedSignal& receivedSignal
+         * @return void
+         */
+        void dispatch(Event event, const ReceivedSignal &receivedSignal);
+
+        /**
+         * Record the values of the mapped axes of a control in the action snapshot
+         *
+         * @param MotionControl* control
+         * @return void
+         */
+        void recordAxes(MotionControl *control);
+
+        /**
+         * Process tick
+         *
+         * Finds mapped input events for the specified control, in the cases
+         * where a button is held down (Event::ButtonDown)
+         *
+         * @param Control* control
+         * @param Timestamp timestamp Time of the tick
+         * @return void
+         */
+        void processTick(Control *control, Timestamp timestamp);
+
+        /**
+         * Process tick (Keyboard-specific)
+         *
+         * The same as processTick, and also emits Event::ButtonDown for
+         * the held keys which GLFW has no key for, by their scancodes
+         *
+         * @param Keyboard* keyboard
+         * @param Timestamp timestamp Time of the tick
+         * @return void
+         */
+        void processTick(Keyboard *keyboard, Timestamp timestamp);
+
+        /**
+         * Process tick (MotionControl-specific)
+         *
+         * The same as processTick, but for MotionControl
+         * Method is needed to avoid slicing of MotionControl properties
+         *
+         * @param MotionControl* control
+         * @param Timestamp timestamp Time of the tick
+         * @return void
+         */
+        void processTick(MotionControl *motionControl, Timestamp timestamp);
+
+        /**
+         * Tick
+         *
+         * Should be called on every iteration of render/game loop, in order
+         * to handle button-down and joystick-related events, as well as
+         * inputs queued in buffered mode
+         *
+         * Reads the joysticks and gamepads from GLFW, and so must be called on the
+         * main thread, unless in buffered mode where they're read by poll instead
+         *
+         * @return void
+         */
+        void tick()
+        {
+            drain();
+            advance(Clock::now());
+        }
+
+        /**
+         * Advance
+         *
+         * Handles the button-down states, and the joysticks and gamepads,
+         * for a tick which happened at the given time. Called by tick, and
+         * by InputPlayer with the recorded time of each tick.
+         *
+         * @param Timestamp timestamp
+         * @return void
+         */
+        void advance(Timestamp timestamp);
+
+        /**
+         * Set action snapshot
+         *
+         * Records the signals of each tick in an ActionSnapshot, which is
+         * published at the end of the tick, and can be read with
+         * getActionSnapshot. Signals without listeners aren't reported
+         * as leaked in this mode.
+         *
+         * @see https://glfw-inputs.readthedocs.io/en/latest/controls/action-snapshot/
+         * @param bool enabled
+         * @return void
+         */
+        void setActionSnapshot(bool enabled)
+        {
+            actionSnapshot = enabled;
+        }
+
+        /**
+         * Returns true if action snapshots are recorded
+         *
+         * @return bool
+         */
+        [[nodiscard]] bool isActionSnapshot() const
+        {
+            return actionSnapshot;
+        }
+
+        /**
+         * Get the action snapshot of the most recent tick
+         *
+         * The snapshot can be read from any thread without locking, until
+         * the end of the next tick, which reuses its storage.
+         *
+         * @return const ActionSnapshot&
+         */
+        [[nodiscard]] const ActionSnapshot &getActionSnapshot() const;
+
+        /**
+         * Set raw mouse motion
+         *
+         * Disables the cursor, and enables raw (unaccelerated) mouse motion where
+         * supported. The movement of each tick is then accumulated in double
+         * precision, delivered to onMove as MotionSurface::MouseRaw, and
+         * available with Mouse::getRawDelta. Cursor movements aren't
+         * delivered while raw mouse motion is enabled.
+         *
+         * @param bool enabled
+         * @return bool False if raw motion isn't supported, in which case the
+         *              movement is still unbounded, but accelerated by the OS
+         */
+        bool setRawMouseMotion(bool enabled)
+        {
+            rawMouseMotion = enabled;
+            lastRawCursor.reset();
+            return backend->setRawMouseMotion(enabled);
+        }
+
+        /**
+         * Returns true if raw mouse motion is enabled
+         *
+         * @return bool
+         */
+        [[nodiscard]] bool isRawMouseMotion() const
+        {
+            return rawMouseMotion;
+        }
+
+        /**
+         * Set coalesced motion
+         *
+         * By default, onMove is called for every cursor and scroll event
+         * received from GLFW, which with high polling-rate mice can be
+         * thousands of times per second. With coalesced motion, the movements
+         * are accumulated, and delivered once per tick: the cursor with its
+         * latest position and the summed relative movement, and the wheel
+         * with the summed scroll.
+         *
+         * @param bool enabled
+         * @param bool keepSamples Keep the individual samples, available as MotionEvent::samples
+         * @return void
+         */
+        void setCoalescedMotion(bool enabled, bool keepSamples = false)
+        {
+            coalesceMotion = enabled;
+            keepMotionSamples = enabled && keepSamples;
+        }
+
+        /**
+         * Returns true if mouse motion is coalesced per tick
+         *
+         * @return bool
+         */
+        [[nodiscard]] bool isCoalescedMotion() const
+        {
+            return coalesceMotion;
+        }
+
+        /**
+         * Process coalesced motion
+         *
+         * Delivers the mouse motion accumulated since the previous tick.
+         * Called by tick.
+         *
+         * @return void
+         */
+        void processCoalescedMotion();
+
+        /**
+         * Set recorder
+         *
+         * Records all inputs processed by the manager, until the
+         * recorder is unset (with nullptr). The recorder must outlive
+         * its use by the manager.
+         *
+         * @param InputRecorder* recorder
+         * @return void
+         */
+        void setRecorder(InputRecorder *inputRecorder)
+        {
+            recorder = inputRecorder;
+        }
+
+        /**
+         * Process joysticks
+         *
+         * Iterates over the connected joysticks/gamepads, and
+         * looks for button presses and movements on the axes.
+         * In buffered mode, their states are taken from the latest poll.
+         *
+         * The way button presses are detected on joysticks is different
+         * from mouse and keyboard, in that joysticks don't have
+         * a specific callback for it. Instead, the button states are compared
+         * with those of the previous tick.
+         *
+         * The axes of all joysticks are gathered in an AxisBatch, which is
+         * filtered and checked for changes in one pass, after which
+         * only the moved axes are dispatched.
+         *
+         * @param Timestamp timestamp
+         * @return void
+         */
+        void processJoysticks(Timestamp timestamp = Clock::now());
+
+        /**
+         * Process axis thresholds
+         *
+         * Evaluates the axis thresholds of the mapping on a surface, and
+         * emits their press, down and release events
+         *
+         * @param MotionControl* control
+         * @param SupportsMultipleDevices* device
+         * @param MotionSurface surface
+         * @param Position position The filtered position of the surface
+         * @param Timestamp timestamp
+         * @return void
+         */
+        void processAxisThresholds(MotionControl *control,
+                                   SupportsMultipleDevices *device,
+                                   MotionSurface surface,
+                                   Position position,
+                                   Timestamp timestamp);
+
+        /**
+         * Process gamepads
+         *
+         * Reads the state of each gamepad (a single GLFW call per gamepad),
+         * or takes it from the latest poll in buffered mode, and emits
+         * button events and movements of the sticks and triggers
+         *
+         * @param Timestamp timestamp
+         * @return void
+         */
+        void processGamepads(Timestamp timestamp = Clock::now());
+
+        /**
+         * Process joystick buttons
+         *
+         * Packs the GLFW button states into a ButtonSet, and
+         * processes them with processButtonStates
+         *
+         * @param Joystick* joystick
+         * @param const unsigned char* buttons GLFW button states
+         * @param int count Number of buttons
+         * @param Timestamp timestamp
+         * @return void
+         */
+        void processJoystickButtons(Joystick *joystick,
+                                    const unsigned char *buttons,
+                                    int count,
+                                    Timestamp timestamp);
+
+        /**
+         * Process button states
+         *
+         * Used for controls without button callbacks (joysticks and gamepads).
+         * Compares the current button states word-wise (XOR) with the states
+         * of the previous tick, to emit ButtonPress and ButtonRelease events.
+         * ButtonDown is emitted for all held buttons.
+         *
+         * @param MotionControl* control
+         * @param const ButtonSet<inputCount>& current
+         * @param Timestamp timestamp
+         * @return void
+         */
+        void processButtonStates(MotionControl *control,
+                                 const ButtonSet<inputCount> &current,
+                                 Timestamp timestamp);
+
+        /**
+         * Handle a single button event of a joystick or gamepad
+         *
+         * @param MotionControl* control
+         * @param Event event
+         * @param Input input
+         * @param Timestamp timestamp
+         * @return void
+         */
+        void handleButton(MotionControl *control, Event event, Input input, Timestamp timestamp);
+
+        /**
+         * Helper function to map a button index to the
+         * corresponding enumerator value in Input
+         *
+         * @param int btn
+         * @return Input
+         */
+        static Input translateJoystickButton(int btn);
+
+        /**
+         * Helper function to map a gamepad button index
+         * (GLFW_GAMEPAD_BUTTON_*) to the corresponding enumerator value in Input
+         *
+         * @param int btn
+         * @return Input
+         */
+        static Input translateGamepadButton(int btn);
+
+        /**
+         * Set keyboard
+         *
+         * @param Keyboard* to
+         * @return void
+         */
+        void setKeyboard(Keyboard *to)
+        {
+            keyboard = to;
+        }
+
+        /**
+         * Set mouse
+         *
+         * @param Mouse* to
+         * @return void
+         */
+        void setMouse(Mouse *to)
+        {
+            mouse = to;
+        }
+
+        /**
+         * Set (list of) joysticks
+         *
+         * @param std::vector<Joystick*> to
+         * @return void
+         */
+        void setJoysticks(const std::vector<Joystick*>& to);
+
+        /**
+         * Set (list of) gamepads
+         *
+         * @param std::vector<Gamepad*> to
+         * @return void
+         */
+        void setGamepads(const std::vector<Gamepad*>& to)
+        {
+            gamepads = to;
+        }
+
+        /**
+         * Define what should happen when a signal is emitted
+         *
+         * The callback can be a lambda function, or a reference
+         * to a function or class method. A signal can have several
+         * callbacks, which are invoked in the order they were added.
+         *
+         * @param const std::string& signal
+         * @param SignalHandler callback
+         * @return Subscription Token which can be passed to unlisten
+         */
+        Subscription listenFor(const std::string& signal, SignalHandler callback);
+
+        /**
+         * Stop listening
+         *
+         * Removes a callback added with listenFor
+         *
+         * @param Subscription subscription
+         * @return bool False if the subscription wasn't found
+         */
+        bool unlisten(Subscription subscription);
+
+        /**
+         * The number of joystick buttons represented in Input
+         */
+        static constexpr std::size_t joystickButtonCount = 12;
+
+    private:
+        struct Impl;
+
+        /**
+         * The listeners, the queue and device polls of buffered mode, the action
+         * snapshots and the pending motion (defined in detail/manager-impl.hpp)
+         */
+        std::unique_ptr<Impl> impl;
+
+        std::unique_ptr<InputBackend> ownedBackend;
+        InputBackend *backend;
+
+        bool buffered = false;
+
+        InputRecorder *recorder = nullptr;
+
+        bool actionSnapshot = false;
+
+        bool coalesceMotion = false;
+        bool keepMotionSamples = false;
 
-    };
+        bool rawMouseMotion = false;
+        std::optional<Position> lastRawCursor;
+
+        Keyboard* keyboard = nullptr;
+        Mouse* mouse = nullptr;
+        std::vector<Joystick*> joysticks;
+        std::vector<Gamepad*> gamepads;
+
+        std::optional<Timestamp> previousJoystickTick;
 
-    /**
-     * Received signal
-     *
-     * Struct used for callbacks
-     *
-     * @see https://glfw-inputs.readthedocs.io/en/latest/misc/received-signal/
-     */
-    struct ReceivedSignal {
-        std::string signal;
-        std::optional<SupportsMultipleDevices*> device;
     };
 
     /**
-     * Input Manager
-     *
-     * The input manager class which first and foremost connects with GLFW,
-     * but also handles all callbacks (i.e. communication with GLFW when inputs
-     * are interacted with).
+     * GLFW Backend
      *
-     * Class is also responsible for listening for signals, and exposing the
-     * option to receive those signals to the library consumer.
+     * Connects a manager with the callbacks of a GLFW window, and
+     * reads joystick and gamepad state from GLFW
      *
-     * @see https://glfw-inputs.readthedocs.io/en/latest/controls/input-manager/
+     * @see https://glfw-inputs.readthedocs.io/en/latest/controls/input-backend/
      */
-    class Manager : public Messaging {
+    class GlfwBackend : public InputBackend {
     public:
 
         /**
-         * Create a new instance of the input manager
-         *
-         * @param GLFWwindow* window
+         * @param GLFWwindow* window nullptr to only provide joystick and gamepad state
          */
-        explicit Manager(GLFWwindow *window) : window(window)
-        {
-            // Keyboard
-            glfwSetKeyCallback(window, Manager::keyboardCallback);
+        explicit GlfwBackend(GLFWwindow *window = nullptr) : window(window) { }
 
-            // Mouse
-            glfwSetMouseButtonCallback(window, Manager::mouseButtonCallback);
-            glfwSetCursorPosCallback(window, Manager::mouseMoveCallback);
-            glfwSetScrollCallback(window, Manager::mouseWheelCallback);
+        void attach(Manager &manager) override;
 
-            // Joysticks and gamepads
-            glfwSetJoystickCallback(Manager::joystickConnectionCallback);
+        void detach(Manager &manager) override;
+
+        bool joystickPresent(int jid) override
+        {
+            return glfwJoystickPresent(jid) == GLFW_TRUE;
         }
 
-        /**
-         * GLFW: Joystick callback
-         *
-         * This callback detects when joysticks are connected or
-         * disconnected.
-         *
-         * @param int jid Joystick (device) ID
-         * @param int event GLFW event ID
-         * @return void
-         */
-        static void joystickConnectionCallback(int jid, int event)
+        const char *joystickName(int jid) override
         {
-            std::optional<DeviceEvent> ev;
-            if (event == GLFW_CONNECTED) {
-                ev = DeviceEvent::Connected;
-            } else if (event == GLFW_DISCONNECTED) {
-                ev = DeviceEvent::Disconnected;
-            }
+            return glfwGetJoystickName(jid);
+        }
 
-            if (!ev.has_value()) {
-                return;
-            }
+        const unsigned char *joystickButtons(int jid, int *count) override
+        {
+            return glfwGetJoystickButtons(jid, count);
+        }
 
-            for (Joystick* joystick : joysticks) {
-                if (!joystick->mapping.has_value()) {
-                    continue;
-                }
+        const float *joystickAxes(int jid, int *count) override
+        {
+            return glfwGetJoystickAxes(jid, count);
+        }
 
-                handleMappedDeviceEvent(joystick->mapping.value()->getEvent(ev.value()),
-                                        joystick);
-            }
+        const char *gamepadName(int jid) override
+        {
+            return glfwGetGamepadName(jid);
         }
 
+        bool gamepadState(int jid, GLFWgamepadstate *state) override
+        {
+            return glfwGetGamepadState(jid, state) == GLFW_TRUE;
+        }
+
+        bool setRawMouseMotion(bool enabled) override;
+
         /**
-         * Handle mapped device events
+         * GLFW: Joystick callback
          *
-         * Helper method to find a specific signal and invoke its callback
+         * This callback detects when joysticks are connected or
+         * disconnected, and forwards it to all managers.
          *
-         * @param std::optional<MappedDeviceEvent> mappedDeviceEvent
-         * @param Joystick* joystick
+         * @param int jid Joystick (device) ID
+         * @param int event GLFW event ID
          * @return void
          */
-        static void handleMappedDeviceEvent(std::optional<MappedDeviceEvent> mappedDeviceEvent, Joystick* joystick)
-        {
-            if (!mappedDeviceEvent.has_value()) {
-                return;
-            }
-
-            std::string signal = mappedDeviceEvent.value().signal;
-            for (auto item : callbacks) {
-                if (item.first == signal) {
-                    item.second({
-                        .signal = signal,
-                        .device = joystick,
-                    });
-                    return;
-                }
-            }
-
-            warn("Leaked signal (not handled): " + signal);
-        }
+        static void joystickConnectionCallback(int jid, int event);
 
         /**
          * GLFW: Mouse/cursor movement callback
@@ -702,17 +3078,7 @@ namespace GLFW_Inputs {
          * @param double y
          * @return void
          */
-        static void mouseMoveCallback(GLFWwindow *glfwWindow, double x, double y)
-        {
-            if (!mouse || !mouse->mapping.has_value()) {
-                return;
-            }
-
-            mouse->positionChanged({
-                .x = x,
-                .y = y,
-            }, MotionSurface::MouseCursor);
-        }
+        static void mouseMoveCallback(GLFWwindow *glfwWindow, double x, double y);
 
         /**
          * GLFW: Mouse/scroll wheel callback
@@ -722,44 +3088,18 @@ namespace GLFW_Inputs {
          * @param double y
          * @return void
          */
-        static void mouseWheelCallback(GLFWwindow *glfwWindow, double x, double y)
-        {
-            if (!mouse || !mouse->mapping.has_value()) {
-                return;
-            }
-
-            mouse->relativeChanged({
-                .x = x,
-                .y = y,
-            }, MotionSurface::MouseWheel);
-        }
+        static void mouseWheelCallback(GLFWwindow *glfwWindow, double x, double y);
 
         /**
          * GLFW: Mouse button callback
          *
-         * Note: The handling code cannot be put into a helper method because the
-         * differences between Control and MotionControl would be sliced, and it
-         * would point to the incorrect mapping
-         *
          * @param GLFWwindow* window
          * @param int button
          * @param int action
          * @param int mods
          * @return void
          */
-        static void mouseButtonCallback(GLFWwindow *window, int button, int action, int mods)
-        {
-            if (!mouse || !mouse->mapping.has_value()) {
-                return;
-            }
-
-            InputEvent inputEvent = {
-                .event = action == 0 ? Event::ButtonRelease : Event::ButtonPress,
-                .input = static_cast<Input>(button),
-            };
-            mouse->handle(inputEvent);
-            handleMappedInputEvent(mouse->mapping.value()->getEvent(inputEvent));
-        }
+        static void mouseButtonCallback(GLFWwindow *window, int button, int action, int mods);
 
         /**
          * GLFW: Keyboard button press callback
@@ -771,262 +3111,319 @@ namespace GLFW_Inputs {
          * @param int mods
          * @return void
          */
-        static void keyboardCallback(GLFWwindow *window, int key, int scancode, int action, int mods)
-        {
-            if (!keyboard || !keyboard->mapping.has_value() || action > 1) {
-                return;
-            }
+        static void keyboardCallback(GLFWwindow *window, int key, int scancode, int action, int mods);
 
-            InputEvent inputEvent = {
-                .event = action == 0 ? Event::ButtonRelease : Event::ButtonPress,
-                .input = static_cast<Input>(key),
-            };
-            keyboard->handle(inputEvent);
-            handleMappedInputEvent(keyboard->mapping.value()->getEvent(inputEvent));
-        }
+    private:
+        GLFWwindow *window;
+
+        struct ManagerRegistry;
+
+        static ManagerRegistry &managerRegistry();
 
         /**
-         * Handle mapped input events
-         *
-         * Helper method to find a specific signal and invoke its callback
+         * Find the manager associated with a window
          *
-         * @param std::optional<MappedInputEvent> mappedInputEvent
-         * @return void
+         * @param GLFWwindow* window
+         * @return Manager* nullptr if no manager is associated
          */
-        static void handleMappedInputEvent(std::optional<MappedInputEvent> mappedInputEvent)
-        {
-            if (!mappedInputEvent.has_value()) {
-                return;
-            }
+        static Manager *fromWindow(GLFWwindow *window);
 
-            std::string signal = mappedInputEvent.value().signal;
-            for (auto item : callbacks) {
-                if (item.first == signal) {
-                    item.second({
-                        .signal = signal,
-                    });
-                    return;
-                }
-            }
+    };
 
-            warn("Leaked signal (not handled): " + signal);
-        }
+    /**
+     * Synthetic Backend
+     *
+     * An in-memory backend, which doesn't depend on a display or physical
+     * devices. Inputs are injected by calling its methods, and are delivered
+     * synchronously to the attached managers. Virtual joysticks and gamepads
+     * can be connected, and their buttons and axes set.
+     *
+     * @see https://glfw-inputs.readthedocs.io/en/latest/controls/input-backend/
+     */
+    class SyntheticBackend : public InputBackend {
+    public:
+        SyntheticBackend();
+
+        ~SyntheticBackend() override;
+
+        void attach(Manager &manager) override;
+
+        void detach(Manager &manager) override;
 
         /**
-         * Process tick
-         *
-         * Finds mapped input events for the specified control, in the cases
-         * where a button is held down (Event::ButtonDown)
+         * Inject a key action
          *
-         * @param Control* control
+         * @param int key GLFW key
+         * @param int action GLFW_PRESS, GLFW_RELEASE or GLFW_REPEAT
+         * @param int mods
+         * @param int scancode
          * @return void
          */
-        void processTick(Control *control)
-        {
-            if (!control) {
-                return;
-            }
-            for (auto input : control->getButtonsDown()) {
-                handleMappedInputEvent(control->mapping.value()->getEvent({
-                   .event = Event::ButtonDown,
-                   .input = static_cast<Input>(input),
-                }));
-            }
-        }
+        void key(int key, int action, int mods = 0, int scancode = 0);
 
         /**
-         * Process tick (MotionControl-specific)
+         * Inject a mouse button action
          *
-         * The same as processTick, but for MotionControl
-         * Method is needed to avoid slicing of MotionControl properties
+         * @param int button GLFW mouse button
+         * @param int action GLFW_PRESS or GLFW_RELEASE
+         * @param int mods
+         * @return void
+         */
+        void mouseButton(int button, int action, int mods = 0);
+
+        /**
+         * Inject a cursor movement
          *
-         * @param MotionControl* control
+         * @param double x
+         * @param double y
          * @return void
          */
-        void processTick(MotionControl *motionControl)
-        {
-            if (!motionControl) {
-                return;
-            }
-            for (auto input : motionControl->getButtonsDown()) {
-                handleMappedInputEvent(motionControl->mapping.value()->getEvent({
-                    .event = Event::ButtonDown,
-                    .input = static_cast<Input>(input),
-                }));
-            }
-        }
+        void cursor(double x, double y);
 
         /**
-         * Tick
+         * Inject a scroll
          *
-         * Should be called on every iteration of render/game loop, in order
-         * to handle button-down and joystick-related events
+         * @param double x
+         * @param double y
+         * @return void
+         */
+        void scroll(double x, double y);
+
+        /**
+         * Connect a virtual joystick
          *
+         * @param int jid
+         * @param const std::string& name
+         * @param int buttonCount
+         * @param int axisCount
+         * @param bool gamepad Whether the joystick is also available as a gamepad,
+         *                     with the sticks centered and the triggers released (-1)
          * @return void
          */
-        void tick()
-        {
-            processTick(keyboard);
-            processTick(mouse);
+        void connectJoystick(int jid,
+                             const std::string &name,
+                             int buttonCount,
+                             int axisCount,
+                             bool gamepad = false);
 
-            processJoysticks();
-        }
+        /**
+         * Disconnect a virtual joystick
+         *
+         * @param int jid
+         * @return void
+         */
+        void disconnectJoystick(int jid);
 
         /**
-         * Process joysticks
+         * Set whether a virtual joystick is present, without
+         * notifying the managers (unlike connectJoystick and disconnectJoystick)
          *
-         * Iterates over the connected joysticks/gamepads, and
-         * looks for button presses and movements on the axes
+         * @param int jid
+         * @param bool present
+         * @param const std::string& name
+         * @return void
+         */
+        void setJoystickPresent(int jid, bool present, const std::string &name = "");
+
+        /**
+         * Replace all button and axis states of a virtual joystick
          *
-         * The way button presses are detected on joysticks is different
-         * from mouse and keyboard, in that joysticks don't have
-         * a specific callback for it
+         * The joystick becomes present, if it isn't already
          *
+         * @param int jid
+         * @param const unsigned char* buttons GLFW_PRESS or GLFW_RELEASE per button
+         * @param int buttonCount
+         * @param const float* axes
+         * @param int axisCount
          * @return void
          */
-        void processJoysticks()
-        {
-            for (Joystick* joystick : joysticks) {
-                if (!joystick->isConnected()) {
-                    continue;
-                } else if (!joystick->mapping.has_value()) {
-                    continue;
-                }
-
-                int bCount;
-                const unsigned char *buttons = glfwGetJoystickButtons(joystick->getId(), &bCount);
+        void setJoystickState(int jid,
+                              const unsigned char *buttons,
+                              int buttonCount,
+                              const float *axes,
+                              int axisCount);
 
-                for (int i = 0; i <= bCount; i++) {
-                    if (buttons[i] == GLFW_PRESS) {
-                        handleMappedInputEvent(joystick->mapping.value()->getEvent({
-                            .event = Event::ButtonDown,
-                            .input = translateJoystickButton(i),
-                        }));
-                    }
-                }
-
-                // Look for movements along the different axes
-                // The number of axes can vary between joysticks
-                int countAxes;
-                const float *axes = glfwGetJoystickAxes(joystick->getId(), &countAxes);
-                if (axes) {
-                    Position movement, rotation;
-                    for (int a = 0; a < countAxes; a++) {
-                        switch (a) {
-                            case 0:
-                                movement.x = axes[a];
-                                break;
-                            case 1:
-                                movement.y = axes[a];
-                                break;
-                            case 2:
-                                rotation.x = axes[a];
-                                break;
-                            case 3:
-                                rotation.y = axes[a];
-                                break;
-                        }
-                    }
-
-                    joystick->positionChanged(movement, MotionSurface::JoystickAxesXY);
-                    joystick->positionChanged(rotation, MotionSurface::JoystickRotationXY);
-                }
-            }
-        }
+        /**
+         * Replace the state of a virtual gamepad
+         *
+         * The joystick becomes present and available as a gamepad, if it isn't already
+         *
+         * @param int jid
+         * @param const GLFWgamepadstate& state
+         * @return void
+         */
+        void setGamepadState(int jid, const GLFWgamepadstate &state);
 
         /**
-         * Helper function to map a button index to the
-         * corresponding enumerator value in Input
+         * Set the state of a virtual joystick button
          *
-         * @param int btn
-         * @return Input
+         * @param int jid
+         * @param int button
+         * @param bool pressed
+         * @return void
          */
-        static Input translateJoystickButton(int btn) {
-            std::vector<Input> joystickInputs = {
-                    Input::JoystickButton1,
-                    Input::JoystickButton2,
-                    Input::JoystickButton3,
-                    Input::JoystickButton4,
-                    Input::JoystickButton5,
-                    Input::JoystickButton6,
-                    Input::JoystickButton7,
-                    Input::JoystickButton8,
-                    Input::JoystickButton9,
-                    Input::JoystickButton10,
-                    Input::JoystickButton11,
-                    Input::JoystickButton12
-            };
-            return joystickInputs[btn];
-        }
+        void setJoystickButton(int jid, int button, bool pressed);
 
         /**
-         * Set keyboard
+         * Set the value of a virtual joystick axis
          *
-         * @param Keyboard* to
+         * @param int jid
+         * @param int axis
+         * @param float value
          * @return void
          */
-        void setKeyboard(Keyboard *to)
-        {
-            keyboard = to;
-        }
+        void setJoystickAxis(int jid, int axis, float value);
 
         /**
-         * Set mouse
+         * Set the state of a virtual gamepad button
          *
-         * @param Mouse* to
+         * @param int jid
+         * @param int button GLFW_GAMEPAD_BUTTON_*
+         * @param bool pressed
          * @return void
          */
-        void setMouse(Mouse *to)
-        {
-            mouse = to;
-        }
+        void setGamepadButton(int jid, int button, bool pressed);
 
         /**
-         * Set (list of) joysticks
+         * Set the value of a virtual gamepad axis
          *
-         * @param std::vector<Joystick*> to
+         * @param int jid
+         * @param int axis GLFW_GAMEPAD_AXIS_*
+         * @param float value
          * @return void
          */
-        void setJoysticks(const std::vector<Joystick*>& to)
+        void setGamepadAxis(int jid, int axis, float value);
+
+        bool joystickPresent(int jid) override;
+
+        const char *joystickName(int jid) override;
+
+        const unsigned char *joystickButtons(int jid, int *count) override;
+
+        const float *joystickAxes(int jid, int *count) override;
+
+        const char *gamepadName(int jid) override;
+
+        bool gamepadState(int jid, GLFWgamepadstate *state) override;
+
+        bool setRawMouseMotion(bool enabled) override
         {
-            joysticks = to;
+            rawMouseMotion = enabled;
+            return true;
         }
 
         /**
-         * Define what should happen when a signal is emitted
-         *
-         * The callback can be a lambda function, or a reference
-         * to a function or class method
+         * Returns true if raw mouse motion has been enabled by a manager
          *
-         * @param const std::string& signal
-         * @param std::function<void(ReceivedSignal)> callback
-         * @return void
+         * @return bool
          */
-        void listenFor(const std::string& signal, std::function<void(ReceivedSignal)> callback)
+        [[nodiscard]] bool isRawMouseMotion() const
         {
-            callbacks[signal] = std::move(callback);
+            return rawMouseMotion;
         }
 
     private:
-        GLFWwindow *window;
+        struct VirtualJoystick;
+
+        struct Impl;
+
+        /**
+         * The attached managers and the virtual joysticks
+         */
+        std::unique_ptr<Impl> impl;
 
-        static std::map<std::string, std::function<void(ReceivedSignal)>> callbacks;
+        bool rawMouseMotion = false;
 
-        static Keyboard* keyboard;
-        static Mouse* mouse;
-        static std::vector<Joystick*> joysticks;
+        VirtualJoystick *find(int jid);
 
     };
 
-    // Initialization of static class properties
-    std::map<std::string, std::function<void(ReceivedSignal)>> Manager::callbacks = {};
-    Keyboard* Manager::keyboard = nullptr;
-    Mouse* Manager::mouse = nullptr;
-    std::vector<Joystick*> Manager::joysticks = {};
+    /**
+     * Input Player
+     *
+     * Replays a recording made with InputRecorder. Inputs are submitted
+     * to the manager, and joystick and gamepad states are set on a
+     * SyntheticBackend, so they go through the same processing as
+     * when they were recorded.
+     *
+     * The recording is replayed tick by tick (frame by frame), and the
+     * timestamps keep the intervals of the recording, relative to the
+     * moment the player was created.
+     *
+     * The joysticks and gamepads of the manager should be created
+     * with the backend of the player.
+     *
+     * @see https://glfw-inputs.readthedocs.io/en/latest/misc/recording/
+     */
+    class InputPlayer : public Messaging {
+    public:
+
+        /**
+         * @param std::istream& stream The recording, opened in binary mode
+         * @param Manager& manager
+         * @param SyntheticBackend& backend
+         * @param std::size_t bufferSize Number of bytes read from the stream at a time (at least 16)
+         */
+        InputPlayer(std::istream &stream,
+                    Manager &manager,
+                    SyntheticBackend &backend,
+                    std::size_t bufferSize = 64 * 1024);
+
+        InputPlayer(const InputPlayer &) = delete;
+
+        InputPlayer &operator=(const InputPlayer &) = delete;
+
+        ~InputPlayer();
+
+        /**
+         * Replay the next tick
+         *
+         * Submits the inputs recorded since the previous tick, and
+         * advances the manager by one tick.
+         *
+         * @return bool False when the end of the recording is reached
+         */
+        bool step();
+
+        /**
+         * Replay the remaining recording
+         *
+         * @return std::size_t The number of replayed ticks
+         */
+        std::size_t play();
+
+        /**
+         * Returns the number of ticks replayed so far
+         *
+         * @return std::size_t
+         */
+        [[nodiscard]] std::size_t getTicks() const;
+
+        /**
+         * Returns true when the end of the recording is reached
+         *
+         * @return bool
+         */
+        [[nodiscard]] bool isFinished() const;
 
-    MessagingMethod Messaging::warnings = MessagingMethod::StdCout;
-    MessagingMethod Messaging::errors = MessagingMethod::Exception;
+    private:
+        struct Impl;
+
+        /**
+         * The buffered reader, and the replayed time
+         */
+        std::unique_ptr<Impl> impl;
+
+    };
 
 }
 
+#ifndef GLFW_INPUTS_COMPILED_LIB
+#include "detail/signals-impl.hpp"
+#include "detail/controls-impl.hpp"
+#include "detail/manager-impl.hpp"
+#include "detail/backend-impl.hpp"
+#include "detail/recording-impl.hpp"
+#endif
+
 #endif
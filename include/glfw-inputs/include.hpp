@@ -3,4 +3,17 @@
 
 #include <GLFW/glfw3.h>
 
+/**
+ * Compiled library
+ *
+ * By default, GLFW Inputs is header-only, and the definitions of the
+ * larger classes are inline. The glfw_inputs CMake target defines
+ * GLFW_INPUTS_COMPILED_LIB, which compiles them once in the library instead.
+ */
+#ifdef GLFW_INPUTS_COMPILED_LIB
+#define GLFW_INPUTS_INLINE
+#else
+#define GLFW_INPUTS_INLINE inline
+#endif
+
 #endif
@@ -0,0 +1,205 @@
+#ifndef GLFW_INPUTS_TESTS_INPUT_NAMES_HPP
+#define GLFW_INPUTS_TESTS_INPUT_NAMES_HPP
+
+#include "enums.hpp"
+#include <optional>
+#include <string_view>
+
+namespace GLFW_Inputs {
+
+    /**
+     * Input Name
+     *
+     * The name of an enumerator of Input, as written in the source
+     */
+    struct InputName {
+        std::string_view name;
+        Input input;
+    };
+
+    /**
+     * Names of all enumerators of Input
+     * Must be kept in sync with the Input enumeration
+     *
+     * Inputs of different controls share values (such as MouseButton1
+     * and GamepadA), so names are looked up by prefix when writing
+     */
+    inline constexpr InputName inputNames[] = {
+        {"KeyEsc",             KeyEsc},
+        {"KeyCtrlLeft",        KeyCtrlLeft},
+        {"KeyCtrlRight",       KeyCtrlRight},
+        {"KeyAltLeft",         KeyAltLeft},
+        {"KeyAltRight",        KeyAltRight},
+        {"KeyShiftLeft",       KeyShiftLeft},
+        {"KeyShiftRight",      KeyShiftRight},
+        {"KeyCapsLock",        KeyCapsLock},
+        {"KeyTab",             KeyTab},
+        {"KeyPrintScreen",     KeyPrintScreen},
+        {"KeyInsert",          KeyInsert},
+        {"KeyNumLock",         KeyNumLock},
+        {"KeyScrollLock",      KeyScrollLock},
+        {"KeyPause",           KeyPause},
+        {"KeySpace",           KeySpace},
+        {"KeyBackspace",       KeyBackspace},
+        {"KeyEnter",           KeyEnter},
+        {"KeyDelete",          KeyDelete},
+        {"KeyF1",              KeyF1},
+        {"KeyF2",              KeyF2},
+        {"KeyF3",              KeyF3},
+        {"KeyF4",              KeyF4},
+        {"KeyF5",              KeyF5},
+        {"KeyF6",              KeyF6},
+        {"KeyF7",              KeyF7},
+        {"KeyF8",              KeyF8},
+        {"KeyF9",              KeyF9},
+        {"KeyF10",             KeyF10},
+        {"KeyF11",             KeyF11},
+        {"KeyF12",             KeyF12},
+        {"KeyA",               KeyA},
+        {"KeyB",               KeyB},
+        {"KeyC",               KeyC},
+        {"KeyD",               KeyD},
+        {"KeyE",               KeyE},
+        {"KeyF",               KeyF},
+        {"KeyG",               KeyG},
+        {"KeyH",               KeyH},
+        {"KeyI",               KeyI},
+        {"KeyJ",               KeyJ},
+        {"KeyK",               KeyK},
+        {"KeyL",               KeyL},
+        {"KeyM",               KeyM},
+        {"KeyN",               KeyN},
+        {"KeyO",               KeyO},
+        {"KeyP",               KeyP},
+        {"KeyQ",               KeyQ},
+        {"KeyR",               KeyR},
+        {"KeyS",               KeyS},
+        {"KeyT",               KeyT},
+        {"KeyU",               KeyU},
+        {"KeyV",               KeyV},
+        {"KeyW",               KeyW},
+        {"KeyX",               KeyX},
+        {"KeyY",               KeyY},
+        {"KeyZ",               KeyZ},
+        {"Key0",               Key0},
+        {"Key1",               Key1},
+        {"Key2",               Key2},
+        {"Key3",               Key3},
+        {"Key4",               Key4},
+        {"Key5",               Key5},
+        {"Key6",               Key6},
+        {"Key7",               Key7},
+        {"Key8",               Key8},
+        {"Key9",               Key9},
+        {"KeyPeriod",          KeyPeriod},
+        {"KeyComma",           KeyComma},
+        {"KeySemicolon",       KeySemicolon},
+        {"KeyUp",              KeyUp},
+        {"KeyDown",            KeyDown},
+        {"KeyLeft",            KeyLeft},
+        {"KeyRight",           KeyRight},
+        {"KeyHome",            KeyHome},
+        {"KeyEnd",             KeyEnd},
+        {"KeyPageDown",        KeyPageDown},
+        {"KeyPageUp",          KeyPageUp},
+        {"KeySlash",           KeySlash},
+        {"KeyEqual",           KeyEqual},
+        {"KeyDash",            KeyDash},
+        {"KeyGraveAccent",     KeyGraveAccent},
+        {"KeyApostrophe",      KeyApostrophe},
+        {"KeyBracketLeft",     KeyBracketLeft},
+        {"KeyBracketRight",    KeyBracketRight},
+        {"KeyNumpad0",         KeyNumpad0},
+        {"KeyNumpad1",         KeyNumpad1},
+        {"KeyNumpad2",         KeyNumpad2},
+        {"KeyNumpad3",         KeyNumpad3},
+        {"KeyNumpad4",         KeyNumpad4},
+        {"KeyNumpad5",         KeyNumpad5},
+        {"KeyNumpad6",         KeyNumpad6},
+        {"KeyNumpad7",         KeyNumpad7},
+        {"KeyNumpad8",         KeyNumpad8},
+        {"KeyNumpad9",         KeyNumpad9},
+        {"KeyNumpadAdd",       KeyNumpadAdd},
+        {"KeyNumpadSubtract",  KeyNumpadSubtract},
+        {"KeyNumpadMultiply",  KeyNumpadMultiply},
+        {"KeyNumpadDivide",    KeyNumpadDivide},
+        {"KeyNumpadDecimal",   KeyNumpadDecimal},
+        {"KeyNumpadEqual",     KeyNumpadEqual},
+        {"KeyNumpadEnter",     KeyNumpadEnter},
+        {"MousePrimary",       MousePrimary},
+        {"MouseSecondary",     MouseSecondary},
+        {"MouseMiddle",        MouseMiddle},
+        {"MouseButton1",       MouseButton1},
+        {"MouseButton2",       MouseButton2},
+        {"MouseButton3",       MouseButton3},
+        {"MouseButton4",       MouseButton4},
+        {"MouseButton5",       MouseButton5},
+        {"MouseButton6",       MouseButton6},
+        {"MouseButton7",       MouseButton7},
+        {"MouseButton8",       MouseButton8},
+        {"JoystickButton1",    JoystickButton1},
+        {"JoystickButton2",    JoystickButton2},
+        {"JoystickButton3",    JoystickButton3},
+        {"JoystickButton4",    JoystickButton4},
+        {"JoystickButton5",    JoystickButton5},
+        {"JoystickButton6",    JoystickButton6},
+        {"JoystickButton7",    JoystickButton7},
+        {"JoystickButton8",    JoystickButton8},
+        {"JoystickButton9",    JoystickButton9},
+        {"JoystickButton10",   JoystickButton10},
+        {"JoystickButton11",   JoystickButton11},
+        {"JoystickButton12",   JoystickButton12},
+        {"GamepadA",           GamepadA},
+        {"GamepadB",           GamepadB},
+        {"GamepadX",           GamepadX},
+        {"GamepadY",           GamepadY},
+        {"GamepadLeftBumper",  GamepadLeftBumper},
+        {"GamepadRightBumper", GamepadRightBumper},
+        {"GamepadBack",        GamepadBack},
+        {"GamepadStart",       GamepadStart},
+        {"GamepadGuide",       GamepadGuide},
+        {"GamepadLeftThumb",   GamepadLeftThumb},
+        {"GamepadRightThumb",  GamepadRightThumb},
+        {"GamepadDpadUp",      GamepadDpadUp},
+        {"GamepadDpadRight",   GamepadDpadRight},
+        {"GamepadDpadDown",    GamepadDpadDown},
+        {"GamepadDpadLeft",    GamepadDpadLeft},
+    };
+
+    /**
+     * Find an input by its name
+     *
+     * @param std::string_view name
+     * @return std::optional<Input>
+     */
+    constexpr std::optional<Input> findInput(std::string_view name)
+    {
+        for (const InputName &inputName : inputNames) {
+            if (inputName.name == name) {
+                return inputName.input;
+            }
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * Find the name of an input, among the names with the given prefix
+     * (such as "Key" or "Gamepad")
+     *
+     * @param Input input
+     * @param std::string_view prefix
+     * @return std::string_view Empty if the input has no such name
+     */
+    constexpr std::string_view findInputName(Input input, std::string_view prefix)
+    {
+        for (const InputName &inputName : inputNames) {
+            if (inputName.input == input && inputName.name.substr(0, prefix.size()) == prefix) {
+                return inputName.name;
+            }
+        }
+        return {};
+    }
+
+}
+
+#endif
@@ -0,0 +1,963 @@
+#ifndef GLFW_INPUTS_TESTS_MAPPING_PROFILE_HPP
+#define GLFW_INPUTS_TESTS_MAPPING_PROFILE_HPP
+
+#include "glfw-inputs.hpp"
+#include "binary-stream.hpp"
+#include "input-names.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <locale>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace GLFW_Inputs {
+
+    /**
+     * Mapping Profile
+     *
+     * Saves mappings to, and loads them from, profiles in one of two formats:
+     *
+     * - Text, one mapping per line, for editing by hand
+     * - Binary, compact and quick to load, with each signal name stored once
+     *
+     * Profiles contain the input, scancode and device mappings, and for
+     * motion mappings the axis thresholds, axes and AxisFilter.
+     * Chords and sequences aren't part of profiles.
+     *
+     * Loading adds the mappings of the profile to the given mapping,
+     * which is typically empty.
+     *
+     * @see https://glfw-inputs.readthedocs.io/en/latest/controls/mapping-profiles/
+     */
+    class MappingProfile : public Messaging {
+    public:
+        static constexpr char magic[4] = {'G', 'L', 'M', 'P'};
+
+        static constexpr std::uint8_t version = 1;
+
+        /**
+         * First line of text profiles
+         */
+        static constexpr std::string_view textHeader = "glfw-inputs-profile 1";
+
+        /**
+         * Save a mapping to a file
+         *
+         * @param const std::filesystem::path& path
+         * @param const Mapping& mapping
+         * @param ProfileFormat format
+         * @return bool False if the file couldn't be written
+         */
+        template<typename Mapping>
+        static bool save(const std::filesystem::path &path, const Mapping &mapping, ProfileFormat format)
+        {
+            std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+            if (!stream) {
+                error("Couldn't write mapping profile: " + path.string());
+                return false;
+            }
+
+            if (format == ProfileFormat::Binary) {
+                writeBinary(stream, mapping);
+            } else {
+                writeText(stream, mapping);
+            }
+            return static_cast<bool>(stream);
+        }
+
+        /**
+         * Load a mapping from a file, in either format
+         *
+         * @param const std::filesystem::path& path
+         * @param Mapping& mapping
+         * @return bool False if the file couldn't be read, or is invalid
+         */
+        template<typename Mapping>
+        static bool load(const std::filesystem::path &path, Mapping &mapping)
+        {
+            std::ifstream stream(path, std::ios::binary);
+            if (!stream) {
+                error("Couldn't read mapping profile: " + path.string());
+                return false;
+            }
+
+            if (stream.peek() == magic[0]) {
+                return readBinary(stream, mapping);
+            }
+            return readText(stream, mapping);
+        }
+
+        /**
+         * Write a mapping in the text format
+         *
+         * @param std::ostream& stream
+         * @param const Mapping& mapping
+         * @return void
+         */
+        template<typename Mapping>
+        static void writeText(std::ostream &stream, const Mapping &mapping)
+        {
+            std::ostringstream text;
+            text.imbue(std::locale::classic());
+
+            text << textHeader << "\n";
+
+            for (const MappedInputEvent &mapped : mapping.getInputEvents()) {
+                const InputEvent &inputEvent = mapped.inputEvent;
+                if (inputEvent.scancode > 0) {
+                    text << "scancode " << eventNames[static_cast<std::size_t>(inputEvent.event)]
+                         << " " << inputEvent.scancode;
+                } else {
+                    text << "input " << eventNames[static_cast<std::size_t>(inputEvent.event)]
+                         << " " << inputText(inputEvent.input, inputPrefix<Mapping>());
+                }
+                text << " " << mapped.signal;
+                if (inputEvent.mods != anyModifiers) {
+                    text << " " << modifiersText(inputEvent.mods);
+                }
+                text << "\n";
+            }
+
+            for (const MappedDeviceEvent &mapped : mapping.getDeviceEvents()) {
+                text << "device " << deviceEventNames[static_cast<std::size_t>(mapped.deviceEvent)]
+                     << " " << mapped.signal << "\n";
+            }
+
+            if constexpr (std::is_base_of_v<MotionControlMapping, Mapping>) {
+                for (const MappedAxisThreshold &mapped : mapping.getAxisThresholds()) {
+                    const AxisThreshold &axisThreshold = mapped.axisThreshold;
+                    text << "threshold " << eventNames[static_cast<std::size_t>(mapped.event)]
+                         << " " << surfaceNames[static_cast<std::size_t>(axisThreshold.surface)]
+                         << " " << (axisThreshold.axis == Axis::X ? "x" : "y")
+                         << " " << number(axisThreshold.threshold)
+                         << " " << number(axisThreshold.hysteresis)
+                         << " " << mapped.signal << "\n";
+                }
+
+                for (const MappedAxis &mapped : mapping.getAxes()) {
+                    text << "axis " << surfaceNames[static_cast<std::size_t>(mapped.surface)]
+                         << " " << mapped.signal << "\n";
+                }
+
+                const AxisFilter &filter = mapping.axisFilter;
+                text << "filter"
+                     << " deadzone=" << deadzoneNames[static_cast<std::size_t>(filter.deadzone)]
+                     << " inner=" << number(filter.innerDeadzone)
+                     << " outer=" << number(filter.outerDeadzone)
+                     << " exponent=" << number(filter.exponent)
+                     << " smoothing=" << smoothingNames[static_cast<std::size_t>(filter.smoothing)]
+                     << " factor=" << number(filter.smoothingFactor)
+                     << " min_cutoff=" << number(filter.minCutoff)
+                     << " beta=" << number(filter.beta)
+                     << " derivative_cutoff=" << number(filter.derivativeCutoff)
+                     << " threshold=" << number(filter.threshold) << "\n";
+            }
+
+            stream << text.str();
+        }
+
+        /**
+         * Read a mapping in the text format
+         *
+         * @param std::istream& stream
+         * @param Mapping& mapping
+         * @return bool False if the profile is invalid
+         */
+        template<typename Mapping>
+        static bool readText(std::istream &stream, Mapping &mapping)
+        {
+            std::string line;
+            std::size_t lineNumber = 0;
+            bool header = false;
+
+            while (std::getline(stream, line)) {
+                lineNumber++;
+                std::istringstream tokens(line);
+                tokens.imbue(std::locale::classic());
+
+                std::string directive;
+                if (!(tokens >> directive) || directive[0] == '#') {
+                    continue;
+                }
+
+                if (!header) {
+                    std::string profileVersion;
+                    tokens >> profileVersion;
+                    if (directive + " " + profileVersion != textHeader) {
+                        return invalid(lineNumber, "Expected \"" + std::string(textHeader) + "\"");
+                    }
+                    header = true;
+                    continue;
+                }
+
+                if (!readTextLine(directive, tokens, mapping)) {
+                    return invalid(lineNumber, line);
+                }
+            }
+
+            if (!header) {
+                return invalid(lineNumber, "Empty profile");
+            }
+            return true;
+        }
+
+        /**
+         * Write a mapping in the binary format
+         *
+         * @param std::ostream& stream
+         * @param const Mapping& mapping
+         * @return void
+         */
+        template<typename Mapping>
+        static void writeBinary(std::ostream &stream, const Mapping &mapping)
+        {
+            // Each signal name is written once, and referenced by index
+            std::vector<std::string_view> strings;
+            std::unordered_map<std::string_view, std::uint64_t> indexes;
+            auto intern = [&strings, &indexes](std::string_view signal) {
+                auto [it, inserted] = indexes.emplace(signal, strings.size());
+                if (inserted) {
+                    strings.push_back(signal);
+                }
+                return it->second;
+            };
+
+            struct Record {
+                const void *mapped;
+                ProfileRecordType type;
+                std::uint64_t signal;
+            };
+            std::vector<Record> records;
+
+            for (const MappedInputEvent &mapped : mapping.getInputEvents()) {
+                records.push_back({
+                    &mapped,
+                    mapped.inputEvent.scancode > 0 ? ProfileRecordType::Scancode : ProfileRecordType::Input,
+                    intern(mapped.signal),
+                });
+            }
+            for (const MappedDeviceEvent &mapped : mapping.getDeviceEvents()) {
+                records.push_back({&mapped, ProfileRecordType::Device, intern(mapped.signal)});
+            }
+            if constexpr (std::is_base_of_v<MotionControlMapping, Mapping>) {
+                for (const MappedAxisThreshold &mapped : mapping.getAxisThresholds()) {
+                    records.push_back({&mapped, ProfileRecordType::AxisThreshold, intern(mapped.signal)});
+                }
+                for (const MappedAxis &mapped : mapping.getAxes()) {
+                    records.push_back({&mapped, ProfileRecordType::Axis, intern(mapped.signal)});
+                }
+            }
+
+            BinaryWriter writer(stream);
+            writer.writeBytes(magic, sizeof(magic));
+            writer.writeByte(version);
+
+            writer.writeVarint(strings.size());
+            for (std::string_view string : strings) {
+                writer.writeVarint(string.size());
+                writer.writeBytes(string.data(), string.size());
+            }
+
+            for (const Record &record : records) {
+                writer.writeByte(static_cast<std::uint8_t>(record.type));
+                switch (record.type) {
+                    case ProfileRecordType::Input:
+                    case ProfileRecordType::Scancode: {
+                        const auto &inputEvent = static_cast<const MappedInputEvent *>(record.mapped)->inputEvent;
+                        writer.writeByte(static_cast<std::uint8_t>(inputEvent.event));
+                        writer.writeVarint(static_cast<std::uint64_t>(
+                            record.type == ProfileRecordType::Input ? inputEvent.input : inputEvent.scancode));
+                        writer.writeSignedVarint(inputEvent.mods);
+                        break;
+                    }
+                    case ProfileRecordType::Device: {
+                        const auto *mapped = static_cast<const MappedDeviceEvent *>(record.mapped);
+                        writer.writeByte(static_cast<std::uint8_t>(mapped->deviceEvent));
+                        break;
+                    }
+                    case ProfileRecordType::AxisThreshold: {
+                        const auto *mapped = static_cast<const MappedAxisThreshold *>(record.mapped);
+                        writer.writeByte(static_cast<std::uint8_t>(mapped->event));
+                        writer.writeByte(static_cast<std::uint8_t>(mapped->axisThreshold.surface));
+                        writer.writeByte(static_cast<std::uint8_t>(mapped->axisThreshold.axis));
+                        writer.writeDouble(mapped->axisThreshold.threshold);
+                        writer.writeDouble(mapped->axisThreshold.hysteresis);
+                        break;
+                    }
+                    case ProfileRecordType::Axis: {
+                        const auto *mapped = static_cast<const MappedAxis *>(record.mapped);
+                        writer.writeByte(static_cast<std::uint8_t>(mapped->surface));
+                        break;
+                    }
+                    case ProfileRecordType::AxisFilter:
+                        break;
+                }
+                writer.writeVarint(record.signal);
+            }
+
+            if constexpr (std::is_base_of_v<MotionControlMapping, Mapping>) {
+                const AxisFilter &filter = mapping.axisFilter;
+                writer.writeByte(static_cast<std::uint8_t>(ProfileRecordType::AxisFilter));
+                writer.writeByte(static_cast<std::uint8_t>(filter.deadzone));
+                writer.writeDouble(filter.innerDeadzone);
+                writer.writeDouble(filter.outerDeadzone);
+                writer.writeDouble(filter.exponent);
+                writer.writeByte(static_cast<std::uint8_t>(filter.smoothing));
+                writer.writeDouble(filter.smoothingFactor);
+                writer.writeDouble(filter.minCutoff);
+                writer.writeDouble(filter.beta);
+                writer.writeDouble(filter.derivativeCutoff);
+                writer.writeDouble(filter.threshold);
+            }
+        }
+
+        /**
+         * Read a mapping in the binary format
+         *
+         * @param std::istream& stream
+         * @param Mapping& mapping
+         * @return bool False if the profile is invalid
+         */
+        template<typename Mapping>
+        static bool readBinary(std::istream &stream, Mapping &mapping)
+        {
+            BinaryReader reader(stream);
+
+            char header[sizeof(magic)];
+            std::uint8_t profileVersion;
+            if (!reader.readBytes(header, sizeof(header))
+                || !std::equal(std::begin(header), std::end(header), std::begin(magic))
+                || !reader.readByte(profileVersion)
+                || profileVersion != version) {
+                error("Invalid or unsupported mapping profile");
+                return false;
+            }
+
+            std::uint64_t stringCount;
+            if (!reader.readVarint(stringCount)) {
+                return corrupt();
+            }
+            std::vector<std::string> strings;
+            for (std::uint64_t i = 0; i < stringCount; i++) {
+                std::uint64_t length;
+                if (!reader.readVarint(length) || length > maxSignalLength) {
+                    return corrupt();
+                }
+                std::string string(length, '\0');
+                if (!reader.readBytes(string.data(), length)) {
+                    return corrupt();
+                }
+                strings.push_back(std::move(string));
+            }
+
+            auto readSignal = [&reader, &strings](std::string &signal) {
+                std::uint64_t index;
+                if (!reader.readVarint(index) || index >= strings.size()) {
+                    return false;
+                }
+                signal = strings[index];
+                return true;
+            };
+
+            std::uint8_t type;
+            while (reader.readByte(type)) {
+                std::string signal;
+                switch (static_cast<ProfileRecordType>(type)) {
+                    case ProfileRecordType::Input:
+                    case ProfileRecordType::Scancode: {
+                        std::uint8_t event;
+                        std::uint64_t code;
+                        std::int64_t mods;
+                        if (!reader.readByte(event) || event >= eventCount
+                            || !reader.readVarint(code)
+                            || code >= (static_cast<ProfileRecordType>(type) == ProfileRecordType::Input ? inputCount : maxScancode)
+                            || !reader.readSignedVarint(mods)
+                            || !readSignal(signal)) {
+                            return corrupt();
+                        }
+                        if (static_cast<ProfileRecordType>(type) == ProfileRecordType::Input) {
+                            mapping.on(static_cast<Event>(event), static_cast<Input>(code), signal, static_cast<int>(mods));
+                        } else if (!mapScancode(mapping, static_cast<Event>(event), static_cast<int>(code), signal, static_cast<int>(mods))) {
+                            return false;
+                        }
+                        break;
+                    }
+                    case ProfileRecordType::Device: {
+                        std::uint8_t deviceEvent;
+                        if (!reader.readByte(deviceEvent) || deviceEvent > static_cast<std::uint8_t>(DeviceEvent::Disconnected)
+                            || !readSignal(signal)) {
+                            return corrupt();
+                        }
+                        mapping.on(static_cast<DeviceEvent>(deviceEvent), signal);
+                        break;
+                    }
+                    case ProfileRecordType::AxisThreshold: {
+                        std::uint8_t event, surface, axis;
+                        AxisThreshold axisThreshold{};
+                        if (!reader.readByte(event) || event >= eventCount
+                            || !reader.readByte(surface) || surface >= motionSurfaceCount
+                            || !reader.readByte(axis) || axis > static_cast<std::uint8_t>(Axis::Y)
+                            || !reader.readDouble(axisThreshold.threshold)
+                            || !reader.readDouble(axisThreshold.hysteresis)
+                            || !readSignal(signal)) {
+                            return corrupt();
+                        }
+                        axisThreshold.surface = static_cast<MotionSurface>(surface);
+                        axisThreshold.axis = static_cast<Axis>(axis);
+                        if (!mapAxisThreshold(mapping, static_cast<Event>(event), axisThreshold, signal)) {
+                            return false;
+                        }
+                        break;
+                    }
+                    case ProfileRecordType::Axis: {
+                        std::uint8_t surface;
+                        if (!reader.readByte(surface) || surface >= motionSurfaceCount || !readSignal(signal)) {
+                            return corrupt();
+                        }
+                        if (!mapAxis(mapping, static_cast<MotionSurface>(surface), signal)) {
+                            return false;
+                        }
+                        break;
+                    }
+                    case ProfileRecordType::AxisFilter: {
+                        AxisFilter filter;
+                        std::uint8_t deadzone, smoothing;
+                        if (!reader.readByte(deadzone) || deadzone > static_cast<std::uint8_t>(Deadzone::Radial)
+                            || !reader.readDouble(filter.innerDeadzone)
+                            || !reader.readDouble(filter.outerDeadzone)
+                            || !reader.readDouble(filter.exponent)
+                            || !reader.readByte(smoothing) || smoothing > static_cast<std::uint8_t>(Smoothing::OneEuro)
+                            || !reader.readDouble(filter.smoothingFactor)
+                            || !reader.readDouble(filter.minCutoff)
+                            || !reader.readDouble(filter.beta)
+                            || !reader.readDouble(filter.derivativeCutoff)
+                            || !reader.readDouble(filter.threshold)) {
+                            return corrupt();
+                        }
+                        filter.deadzone = static_cast<Deadzone>(deadzone);
+                        filter.smoothing = static_cast<Smoothing>(smoothing);
+                        if (!setAxisFilter(mapping, filter)) {
+                            return false;
+                        }
+                        break;
+                    }
+                    default:
+                        return corrupt();
+                }
+            }
+
+            return true;
+        }
+
+    private:
+        static constexpr std::string_view eventNames[] = {"press", "down", "release"};
+
+        static constexpr std::string_view deviceEventNames[] = {"connected", "disconnected"};
+
+        static constexpr std::string_view surfaceNames[] = {
+            "MouseCursor",
+            "MouseWheel",
+            "MouseRaw",
+            "JoystickAxesXY",
+            "JoystickRotationXY",
+            "GamepadLeftStick",
+            "GamepadRightStick",
+            "GamepadTriggers",
+        };
+
+        static constexpr std::string_view deadzoneNames[] = {"none", "axial", "radial"};
+
+        static constexpr std::string_view smoothingNames[] = {"none", "exponential", "one_euro"};
+
+        struct ModifierName {
+            std::string_view name;
+            Modifier modifier;
+        };
+
+        static constexpr ModifierName modifierNames[] = {
+            {"shift", ModShift},
+            {"ctrl", ModCtrl},
+            {"alt", ModAlt},
+            {"super", ModSuper},
+        };
+
+        /**
+         * Longest signal name accepted in binary profiles
+         */
+        static constexpr std::uint64_t maxSignalLength = 4096;
+
+        /**
+         * Scancodes size the lookup table of the mapping, so they're bounded
+         */
+        static constexpr std::uint64_t maxScancode = 0x10000;
+
+        /**
+         * The prefix of the names of the inputs of a mapping
+         */
+        template<typename Mapping>
+        static constexpr std::string_view inputPrefix()
+        {
+            if constexpr (std::is_base_of_v<KeyboardMapping, Mapping>) {
+                return "Key";
+            } else if constexpr (std::is_base_of_v<MouseMapping, Mapping>) {
+                return "Mouse";
+            } else if constexpr (std::is_base_of_v<JoystickMapping, Mapping>) {
+                return "JoystickButton";
+            } else if constexpr (std::is_base_of_v<GamepadMapping, Mapping>) {
+                return "Gamepad";
+            } else {
+                return {};
+            }
+        }
+
+        /**
+         * The name of an input, or its number if it has no name with the prefix
+         */
+        static std::string inputText(Input input, std::string_view prefix)
+        {
+            std::string_view name = prefix.empty() ? std::string_view() : findInputName(input, prefix);
+            return name.empty() ? std::to_string(input) : std::string(name);
+        }
+
+        /**
+         * The shortest text of a number which reads back as the same number
+         */
+        static std::string number(double value)
+        {
+            std::ostringstream text;
+            text.imbue(std::locale::classic());
+            for (int precision : {15, 17}) {
+                text.str({});
+                text.precision(precision);
+                text << value;
+
+                std::istringstream check(text.str());
+                check.imbue(std::locale::classic());
+                double parsed;
+                if (check >> parsed && parsed == value) {
+                    break;
+                }
+            }
+            return text.str();
+        }
+
+        static std::string modifiersText(int mods)
+        {
+            std::string text;
+            for (const ModifierName &modifierName : modifierNames) {
+                if (mods & modifierName.modifier) {
+                    text += (text.empty() ? "" : "+") + std::string(modifierName.name);
+                }
+            }
+            return text.empty() ? "none" : text;
+        }
+
+        template<std::size_t N>
+        static std::optional<std::size_t> indexOf(const std::string_view (&names)[N], std::string_view name)
+        {
+            for (std::size_t i = 0; i < N; i++) {
+                if (names[i] == name) {
+                    return i;
+                }
+            }
+            return std::nullopt;
+        }
+
+        static std::optional<Input> parseInput(std::string_view text)
+        {
+            if (std::optional<Input> input = findInput(text)) {
+                return input;
+            }
+            std::optional<int> number = parseInteger(text);
+            if (!number.has_value() || number.value() < 0 || number.value() >= static_cast<int>(inputCount)) {
+                return std::nullopt;
+            }
+            return static_cast<Input>(number.value());
+        }
+
+        static std::optional<int> parseInteger(std::string_view text)
+        {
+            if (text.empty() || text.size() > 9
+                || !std::all_of(text.begin(), text.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+                return std::nullopt;
+            }
+            return std::stoi(std::string(text));
+        }
+
+        /**
+         * Parse modifiers, such as "ctrl+shift", "none", or "any"
+         */
+        static std::optional<int> parseModifiers(std::string_view text)
+        {
+            if (text.empty() || text == "any") {
+                return anyModifiers;
+            }
+            if (text == "none") {
+                return ModNone;
+            }
+
+            int mods = ModNone;
+            while (!text.empty()) {
+                std::size_t end = std::min(text.find('+'), text.size());
+                std::string_view name = text.substr(0, end);
+                auto modifierName = std::find_if(std::begin(modifierNames), std::end(modifierNames),
+                                                 [name](const ModifierName &candidate) {
+                                                     return candidate.name == name;
+                                                 });
+                if (modifierName == std::end(modifierNames)) {
+                    return std::nullopt;
+                }
+                mods |= modifierName->modifier;
+                text.remove_prefix(std::min(end + 1, text.size()));
+            }
+            return mods;
+        }
+
+        template<typename Mapping>
+        static bool readTextLine(const std::string &directive, std::istringstream &tokens, Mapping &mapping)
+        {
+            std::string first, second, third, fourth, fifth, sixth;
+
+            if (directive == "input" || directive == "scancode") {
+                if (!(tokens >> first >> second >> third)) {
+                    return false;
+                }
+                tokens >> fourth;
+                std::optional<std::size_t> event = indexOf(eventNames, first);
+                std::optional<int> mods = parseModifiers(fourth);
+                if (!event.has_value() || !mods.has_value()) {
+                    return false;
+                }
+
+                if (directive == "scancode") {
+                    std::optional<int> scancode = parseInteger(second);
+                    return scancode.has_value() && static_cast<std::uint64_t>(scancode.value()) < maxScancode
+                        && mapScancode(mapping, static_cast<Event>(event.value()), scancode.value(), third, mods.value());
+                }
+
+                std::optional<Input> input = parseInput(second);
+                if (!input.has_value()) {
+                    return false;
+                }
+                mapping.on(static_cast<Event>(event.value()), input.value(), third, mods.value());
+                return true;
+            }
+
+            if (directive == "device") {
+                std::optional<std::size_t> deviceEvent;
+                if (!(tokens >> first >> second) || !(deviceEvent = indexOf(deviceEventNames, first))) {
+                    return false;
+                }
+                mapping.on(static_cast<DeviceEvent>(deviceEvent.value()), second);
+                return true;
+            }
+
+            if (directive == "threshold") {
+                if (!(tokens >> first >> second >> third)) {
+                    return false;
+                }
+                std::optional<std::size_t> event = indexOf(eventNames, first);
+                std::optional<std::size_t> surface = indexOf(surfaceNames, second);
+                AxisThreshold axisThreshold{};
+                if (!event.has_value() || !surface.has_value() || (third != "x" && third != "y")
+                    || !(tokens >> axisThreshold.threshold >> axisThreshold.hysteresis >> fourth)) {
+                    return false;
+                }
+                axisThreshold.surface = static_cast<MotionSurface>(surface.value());
+                axisThreshold.axis = third == "x" ? Axis::X : Axis::Y;
+                return mapAxisThreshold(mapping, static_cast<Event>(event.value()), axisThreshold, fourth);
+            }
+
+            if (directive == "axis") {
+                std::optional<std::size_t> surface;
+                if (!(tokens >> first >> second) || !(surface = indexOf(surfaceNames, first))) {
+                    return false;
+                }
+                return mapAxis(mapping, static_cast<MotionSurface>(surface.value()), second);
+            }
+
+            if (directive == "filter") {
+                AxisFilter filter;
+                std::string setting;
+                while (tokens >> setting) {
+                    std::size_t separator = setting.find('=');
+                    if (separator == std::string::npos) {
+                        return false;
+                    }
+                    std::string key = setting.substr(0, separator);
+                    std::istringstream value(setting.substr(separator + 1));
+                    value.imbue(std::locale::classic());
+
+                    if (key == "deadzone" || key == "smoothing") {
+                        std::optional<std::size_t> index = key == "deadzone"
+                            ? indexOf(deadzoneNames, value.str())
+                            : indexOf(smoothingNames, value.str());
+                        if (!index.has_value()) {
+                            return false;
+                        }
+                        if (key == "deadzone") {
+                            filter.deadzone = static_cast<Deadzone>(index.value());
+                        } else {
+                            filter.smoothing = static_cast<Smoothing>(index.value());
+                        }
+                        continue;
+                    }
+
+                    double *field = key == "inner" ? &filter.innerDeadzone
+                        : key == "outer" ? &filter.outerDeadzone
+                        : key == "exponent" ? &filter.exponent
+                        : key == "factor" ? &filter.smoothingFactor
+                        : key == "min_cutoff" ? &filter.minCutoff
+                        : key == "beta" ? &filter.beta
+                        : key == "derivative_cutoff" ? &filter.derivativeCutoff
+                        : key == "threshold" ? &filter.threshold
+                        : nullptr;
+                    if (!field || !(value >> *field)) {
+                        return false;
+                    }
+                }
+                return setAxisFilter(mapping, filter);
+            }
+
+            return false;
+        }
+
+        template<typename Mapping>
+        static bool mapScancode(Mapping &mapping, Event event, int scancode, const std::string &signal, int mods)
+        {
+            if constexpr (std::is_base_of_v<KeyboardMapping, Mapping>) {
+                mapping.onScancode(event, scancode, signal, mods);
+                return true;
+            } else {
+                error("Scancodes can only be mapped on keyboard mappings");
+                return false;
+            }
+        }
+
+        template<typename Mapping>
+        static bool mapAxisThreshold(Mapping &mapping, Event event, AxisThreshold axisThreshold, const std::string &signal)
+        {
+            if constexpr (std::is_base_of_v<MotionControlMapping, Mapping>) {
+                mapping.on(event, axisThreshold, signal);
+                return true;
+            } else {
+                error("Axis thresholds can only be mapped on motion mappings");
+                return false;
+            }
+        }
+
+        template<typename Mapping>
+        static bool mapAxis(Mapping &mapping, MotionSurface surface, const std::string &signal)
+        {
+            if constexpr (std::is_base_of_v<MotionControlMapping, Mapping>) {
+                mapping.onAxis(surface, signal);
+                return true;
+            } else {
+                error("Axes can only be mapped on motion mappings");
+                return false;
+            }
+        }
+
+        template<typename Mapping>
+        static bool setAxisFilter(Mapping &mapping, const AxisFilter &filter)
+        {
+            if constexpr (std::is_base_of_v<MotionControlMapping, Mapping>) {
+                mapping.axisFilter = filter;
+                return true;
+            } else {
+                error("Axis filters can only be set on motion mappings");
+                return false;
+            }
+        }
+
+        static bool invalid(std::size_t lineNumber, const std::string &message)
+        {
+            error("Invalid mapping profile, line " + std::to_string(lineNumber) + ": " + message);
+            return false;
+        }
+
+        static bool corrupt()
+        {
+            error("Corrupt mapping profile");
+            return false;
+        }
+
+    };
+
+    /**
+     * Mapping Profile Watcher
+     *
+     * Keeps a mapping loaded from a profile, and reloads it when the file
+     * changes. The file is checked at most once per interval, and loaded on
+     * a background thread, so dispatching isn't stalled. The new mapping
+     * is swapped in by poll, which should be called between ticks.
+     *
+     * The attached controls, and the mapping contexts of their stacks, are
+     * pointed to the new mapping. The previous mapping is kept until the
+     * next poll, after which references to it (such as from get(), from
+     * context stacks of controls which aren't attached, or signal names of
+     * ReceivedSignal) are invalid.
+     *
+     * @see https://glfw-inputs.readthedocs.io/en/latest/controls/mapping-profiles/
+     */
+    template<typename Mapping>
+    class MappingProfileWatcher : public Messaging {
+    public:
+
+        /**
+         * Load the profile
+         *
+         * @param std::filesystem::path path
+         * @param Clock::duration interval Time between checks of the file
+         */
+        explicit MappingProfileWatcher(std::filesystem::path path,
+                                       Clock::duration interval = std::chrono::milliseconds(500))
+            : path(std::move(path)), interval(interval), current(std::make_unique<Mapping>())
+        {
+            std::error_code errorCode;
+            lastWriteTime = std::filesystem::last_write_time(this->path, errorCode);
+            MappingProfile::load(this->path, *current);
+        }
+
+        ~MappingProfileWatcher()
+        {
+            if (loading.valid()) {
+                loading.wait();
+            }
+        }
+
+        MappingProfileWatcher(const MappingProfileWatcher &) = delete;
+
+        MappingProfileWatcher &operator=(const MappingProfileWatcher &) = delete;
+
+        /**
+         * Use the mapping on a control, and keep it up to date on reloads
+         *
+         * @param Control& control Keyboard, Mouse, Joystick or Gamepad
+         * @return void
+         */
+        template<typename ControlType>
+        void attach(ControlType &control)
+        {
+            control.mapping = current.get();
+            controls.push_back([&control](const Mapping &previous, Mapping &mapping) {
+                control.mapping = &mapping;
+                control.contexts.replace(previous, mapping);
+                control.comboStates.active.clear();
+                if constexpr (std::is_base_of_v<MotionControl, ControlType>) {
+                    control.resetAxisThresholds();
+                }
+            });
+        }
+
+        /**
+         * Check for changes, and swap in a reloaded mapping
+         *
+         * If the reloaded profile is invalid, the current mapping is kept.
+         * Returns true when a new mapping was swapped in. The previous
+         * mapping is destroyed on the next call.
+         *
+         * @param Timestamp now
+         * @return bool
+         */
+        bool poll(Timestamp now = Clock::now())
+        {
+            previous.reset();
+
+            if (loading.valid()) {
+                if (loading.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                    return false;
+                }
+                return swap();
+            }
+
+            if (now - lastCheck < interval) {
+                return false;
+            }
+            lastCheck = now;
+
+            std::error_code errorCode;
+            auto writeTime = std::filesystem::last_write_time(path, errorCode);
+            if (errorCode || writeTime == lastWriteTime) {
+                return false;
+            }
+            lastWriteTime = writeTime;
+
+            loading = std::async(std::launch::async, [profilePath = path]() {
+                auto mapping = std::make_unique<Mapping>();
+                if (!MappingProfile::load(profilePath, *mapping)) {
+                    mapping.reset();
+                }
+                return mapping;
+            });
+            return false;
+        }
+
+        /**
+         * Returns the current mapping
+         *
+         * @return Mapping&
+         */
+        [[nodiscard]] Mapping &get()
+        {
+            return *current;
+        }
+
+    private:
+        std::filesystem::path path;
+
+        Clock::duration interval;
+
+        Timestamp lastCheck{};
+
+        std::filesystem::file_time_type lastWriteTime{};
+
+        std::unique_ptr<Mapping> current;
+
+        /**
+         * The mapping replaced by the latest reload, kept until the next poll
+         */
+        std::unique_ptr<Mapping> previous;
+
+        std::future<std::unique_ptr<Mapping>> loading;
+
+        /**
+         * Point the attached controls to a new mapping
+         */
+        std::vector<std::function<void(const Mapping &, Mapping &)>> controls;
+
+        bool swap()
+        {
+            std::unique_ptr<Mapping> loaded;
+            try {
+                loaded = loading.get();
+            } catch (const std::exception &exception) {
+                warn("Mapping profile not reloaded: " + std::string(exception.what()));
+                return false;
+            }
+            if (!loaded) {
+                warn("Mapping profile not reloaded: " + path.string());
+                return false;
+            }
+
+            for (const auto &control : controls) {
+                control(*current, *loaded);
+            }
+            previous = std::move(current);
+            current = std::move(loaded);
+            return true;
+        }
+
+    };
+
+}
+
+#endif
@@ -0,0 +1 @@
+#include "glfw-inputs/detail/backend-impl.hpp"
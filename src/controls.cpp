@@ -0,0 +1 @@
+#include "glfw-inputs/detail/controls-impl.hpp"
@@ -0,0 +1 @@
+#include "glfw-inputs/detail/manager-impl.hpp"
@@ -0,0 +1 @@
+#include "glfw-inputs/detail/recording-impl.hpp"
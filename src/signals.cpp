@@ -0,0 +1 @@
+#include "glfw-inputs/detail/signals-impl.hpp"